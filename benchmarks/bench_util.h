@@ -0,0 +1,37 @@
+#ifndef BENCH_UTIL_H
+#define BENCH_UTIL_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+
+//   :        
+inline int benchSize(int argc, char** argv, int defaultSize) {
+    if (argc > 1) {
+        int size = std::atoi(argv[1]);
+        if (size > 0) {
+            return size;
+        }
+    }
+    return defaultSize;
+}
+
+inline double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+//   repeats   fn  
+template<typename Fn>
+double bestOfMs(int repeats, Fn fn) {
+    double best = std::numeric_limits<double>::max();
+    for (int i = 0; i < repeats; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        best = std::min(best, elapsedMs(start));
+    }
+    return best;
+}
+
+#endif // BENCH_UTIL_H
\ No newline at end of file
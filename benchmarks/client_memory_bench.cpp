@@ -0,0 +1,112 @@
+#include "contracts.h"
+#include "bench_util.h"
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+
+using namespace std;
+
+//  :       .
+//   ,    
+static atomic<size_t> liveBytes{ 0 };
+static constexpr size_t ALLOCATION_HEADER = alignof(max_align_t);
+
+void* operator new(size_t size) {
+    void* block = malloc(size + ALLOCATION_HEADER);
+    if (!block) throw bad_alloc();
+    *static_cast<size_t*>(block) = size;
+    liveBytes += size;
+    return static_cast<char*>(block) + ALLOCATION_HEADER;
+}
+
+void operator delete(void* ptr) noexcept {
+    if (!ptr) return;
+    void* block = static_cast<char*>(ptr) - ALLOCATION_HEADER;
+    liveBytes -= *static_cast<size_t*>(block);
+    free(block);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    operator delete(ptr);
+}
+
+//    :   std::string
+struct LegacyClient {
+    virtual ~LegacyClient() = default;
+    int id = 0;
+    string companyName;
+    string contactPerson;
+    string phone;
+    string email;
+    string address;
+
+    bool parse(string_view line) {
+        RecordParser parser(line);
+        string_view fields[5];
+        if (!parser.number(id) || !parser.expect('|')) return false;
+        for (int i = 0; i < 5; ++i) {
+            if (!(i < 4 ? parser.field('|', fields[i]) : parser.rest(fields[i]))) return false;
+        }
+        companyName.assign(fields[0]);
+        contactPerson.assign(fields[1]);
+        phone.assign(fields[2]);
+        email.assign(fields[3]);
+        address.assign(fields[4]);
+        return true;
+    }
+};
+
+template<typename C, typename Parse>
+static void measure(const char* name, const vector<string>& lines, Parse parse) {
+    size_t before = liveBytes;
+    vector<C> clients(lines.size());
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < lines.size(); ++i) {
+        parse(clients[i], lines[i]);
+    }
+    double parseMs = elapsedMs(start);
+    double perClient = static_cast<double>(liveBytes - before) / lines.size();
+    printf("  %-13s sizeof %3zu,    %6.1f,  %6.0f \n", name, sizeof(C), perClient, parseMs);
+}
+
+//     :   (PackedStrings)   std::string
+int main(int argc, char** argv) {
+    int count = benchSize(argc, argv, 1000000);
+    const string path = "client_memory_bench.txt";
+    vector<string> lines;
+    {
+        ofstream file(path, ios::binary);
+        for (int id = 1; id <= count; ++id) {
+            string line = to_string(id) + "|  " + to_string(id) + "| ..|+7 (900) " + to_string(1000000 + id) +
+                "|info" + to_string(id) + "@example.com|. , . , . " + to_string(id % 200);
+            file << line << "\n";
+            lines.push_back(move(line));
+        }
+    }
+
+    printf("%d \n", count);
+    measure<LegacyClient>("std::string", lines, [](LegacyClient& c, const string& line) { c.parse(line); });
+
+    //      :  
+    //   BlobArena     ,  
+    size_t before = liveBytes;
+    Repository<Client> clients(path);
+    auto start = chrono::steady_clock::now();
+    clients.loadFromFile();
+    double loadMs = elapsedMs(start);
+    printf("  Repository<Client>:    %.1f,  %.0f \n",
+        static_cast<double>(liveBytes - before) / count, loadMs);
+
+    size_t found = 0;
+    double scanMs = bestOfMs(5, [&] {
+        clients.forEach([&found](const Client& c) {
+            found += c.getCompanyName().find("99") != string_view::npos ? 1 : 0;
+            });
+        });
+    printf("     : %.1f  (%zu)\n", scanMs, found);
+
+    measure<Client>("PackedStrings", lines, [](Client& c, const string& line) { c.parseRecord(line); });
+    remove(path.c_str());
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,41 @@
+#include "contracts.h"
+#include "bench_util.h"
+#include <random>
+
+using namespace std;
+
+//     ID  Repository<Client> (. IdIndex).
+//      10k, 100k  1M 
+static void run(int n) {
+    Repository<Client> clients("id_index_bench_clients.dat");
+    for (int id = 1; id <= n; ++id) {
+        clients.emplace(id, "a", "b", "c", "d", "e");
+    }
+    mt19937 rng(1);
+    const int lookups = 100000;
+    long checksum = 0;
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < lookups; ++i) {
+        checksum += clients.find(static_cast<int>(rng() % n) + 1)->getId();
+    }
+    double findNs = elapsedMs(start) * 1e6 / lookups;
+
+    int removals = n / 2;
+    start = chrono::steady_clock::now();
+    for (int i = 1; i <= removals; ++i) {
+        clients.remove(i * 2);
+    }
+    double removeNs = elapsedMs(start) * 1e6 / max(removals, 1);
+    printf("%8d : find %6.1f , remove %6.1f  (%ld)\n", n, findNs, removeNs, checksum);
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1) {
+        run(benchSize(argc, argv, 10000));
+        return 0;
+    }
+    for (int n : { 10000, 100000, 1000000 }) {
+        run(n);
+    }
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,49 @@
+#include "interval_index.h"
+#include "bench_util.h"
+#include <random>
+
+using namespace std;
+
+// ,    :     .
+//  1-365 ,    10 
+int main(int argc, char** argv) {
+    int count = benchSize(argc, argv, 1000000);
+    mt19937 rng(7);
+    Repository<Contract> contracts("interval_bench.dat");
+    auto intervals = make_shared<ContractIntervalIndex>();
+    contracts.attachIndex(ContractIntervalIndex::INDEX_NAME, intervals);
+    for (int id = 1; id <= count; ++id) {
+        contracts.emplace(id, 1, 1, Date(rng() % 28 + 1, rng() % 12 + 1, 2015 + rng() % 10), 1 + static_cast<int>(rng() % 365),
+            Money(), "", " ", "");
+    }
+    vector<int> days;
+    for (int i = 0; i < 200; ++i) {
+        days.push_back(Date(1, 1, 2015).toDayNumber() + static_cast<int>(rng() % 4000));
+    }
+
+    size_t indexed = 0, scanned = 0, counted = 0, ending = 0;
+    double indexMs = bestOfMs(1, [&] {
+        for (int day : days) indexed += intervals->activeOn(day).size();
+        }) / days.size();
+    double scanMs = bestOfMs(1, [&] {
+        for (int day : days) {
+            for (const Contract& c : contracts.view()) {
+                int start = c.getStartDate().toDayNumber();
+                if (start <= day && start + c.getDuration() > day) scanned++;
+            }
+        }
+        }) / days.size();
+    double countMs = bestOfMs(1, [&] {
+        for (int day : days) counted += intervals->countOverlapping(day, day + 1);
+        }) / days.size();
+    double endingMs = bestOfMs(1, [&] {
+        for (int day : days) ending += intervals->endingBetween(day, day + 30).size();
+        }) / days.size();
+
+    printf("%d ,   %zu   \n", count, indexed / days.size());
+    printf("  activeOn:              %8.3f \n", indexMs);
+    printf("   :       %8.3f \n", scanMs);
+    printf("  countOverlapping:      %8.4f \n", countMs);
+    printf("  endingBetween(30 .): %8.4f   (%zu %zu %zu)\n", endingMs, scanned, counted, ending);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,80 @@
+#include "contracts.h"
+#include "bench_util.h"
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+using namespace std;
+
+//    : stringstream  getline  .
+//        RecordParser
+static bool parseWithStream(const string& line, Contract& contract) {
+    stringstream ss(line);
+    int id, clientId, objectId, duration;
+    Date startDate;
+    double amount;
+    ss >> id >> clientId >> objectId >> startDate >> duration >> amount;
+    if (ss.fail()) return false;
+    size_t pipePos = line.find('|', static_cast<size_t>(ss.tellg()));
+    if (pipePos == string::npos) return false;
+    ss.seekg(static_cast<streamoff>(pipePos + 1));
+    string workType, status, manager;
+    if (!getline(ss, workType, '|')) return false;
+    if (!getline(ss, status, '|')) return false;
+    if (!getline(ss, manager)) return false;
+    contract = Contract(id, clientId, objectId, startDate, duration, Money::fromMinor(llround(amount * 100)),
+        workType, status, manager);
+    return true;
+}
+
+//    :  , RecordParser    
+int main(int argc, char** argv) {
+    int count = benchSize(argc, argv, 1000000);
+    const string path = "parse_bench_contracts.txt";
+    {
+        Repository<Contract> contracts(path);
+        for (int id = 1; id <= count; ++id) {
+            contracts.emplace(id, id % 500 + 1, id % 300 + 1, Date(1 + id % 28, 1 + id % 12, 2020 + id % 5), 30 + id % 400,
+                Money::fromMinor(1000000 + id * 37LL), " ", " ", "  ");
+        }
+        contracts.exportText(path);
+    }
+    vector<string> lines;
+    size_t bytes = 0;
+    {
+        ifstream file(path, ios::binary);
+        string line;
+        while (getline(file, line)) {
+            bytes += line.size() + 1;
+            lines.push_back(move(line));
+        }
+    }
+    double megabytes = static_cast<double>(bytes) / 1e6;
+
+    long checksum = 0;
+    double streamMs = bestOfMs(3, [&] {
+        Contract contract;
+        for (const string& line : lines) {
+            if (parseWithStream(line, contract)) checksum += contract.getDuration();
+        }
+        });
+    double parserMs = bestOfMs(3, [&] {
+        Contract contract;
+        for (const string& line : lines) {
+            if (contract.parseRecord(line)) checksum += contract.getDuration();
+        }
+        });
+    size_t loaded = 0;
+    double loadMs = bestOfMs(3, [&] {
+        Repository<Contract> contracts(path);
+        contracts.loadFromFile();
+        loaded = contracts.size();
+        });
+    remove(path.c_str());
+
+    printf("%d , %.1f \n", count, megabytes);
+    printf("  stringstream:       %8.1f   %6.1f /\n", streamMs, megabytes / (streamMs / 1000));
+    printf("  RecordParser:       %8.1f   %6.1f /\n", parserMs, megabytes / (parserMs / 1000));
+    printf("  loadFromFile:       %8.1f   (%zu , %ld)\n", loadMs, loaded, checksum);
+    return 0;
+}
\ No newline at end of file
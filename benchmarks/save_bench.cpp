@@ -0,0 +1,65 @@
+#include "contracts.h"
+#include "bench_util.h"
+#include <fstream>
+#include <sys/stat.h>
+
+using namespace std;
+
+//  :   operator<<  std::endl,       
+template<typename T, typename Write>
+static void saveWithStream(const Repository<T>& repo, const string& path, Write write) {
+    ofstream file(path);
+    repo.forEach([&file, &write](const T& item) {
+        write(file, item);
+        });
+}
+
+static double fileMegabytes(const string& path) {
+    struct stat info;
+    return stat(path.c_str(), &info) == 0 ? static_cast<double>(info.st_size) / 1e6 : 0.0;
+}
+
+template<typename T, typename Write>
+static void compare(const char* title, const Repository<T>& repo, const string& path, Write write) {
+    double streamMs = bestOfMs(3, [&] { saveWithStream(repo, path, write); });
+    double streamMb = fileMegabytes(path);
+    double writerMs = bestOfMs(3, [&] { repo.exportText(path); });
+    double writerMb = fileMegabytes(path);
+    remove(path.c_str());
+    printf("  %-10s ostream + endl: %7.1f  %6.1f  %6.1f / | RecordWriter: %7.1f  %6.1f  %6.1f /\n",
+        title, streamMs, streamMb, streamMb / (streamMs / 1000), writerMs, writerMb, writerMb / (writerMs / 1000));
+}
+
+//   :    ofstream  RecordWriter
+//       
+int main(int argc, char** argv) {
+    int count = benchSize(argc, argv, 1000000);
+
+    Repository<Contract> contracts("save_bench_contracts.txt");
+    Repository<Client> clients("save_bench_clients.txt");
+    Repository<ConstructionObject> objects("save_bench_objects.txt");
+    for (int id = 1; id <= count; ++id) {
+        contracts.emplace(id, id % 500 + 1, id % 300 + 1, Date(1 + id % 28, 1 + id % 12, 2020 + id % 5), 30 + id % 400,
+            Money::fromMinor(1000000 + id * 37LL), " ", " ", "  ");
+        clients.emplace(id, "  " + to_string(id), " ", "+7 900 " + to_string(1000000 + id),
+            "client" + to_string(id) + "@mail.ru", ". , . , . " + to_string(id % 200));
+        objects.emplace(id, "  " + to_string(id), ". , . , . " + to_string(id % 150),
+            "", 50.0 + id % 5000 * 0.25);
+    }
+
+    printf("%d   \n", count);
+    compare("", contracts, "save_bench_contracts.txt", [](ofstream& file, const Contract& c) {
+        file << c.getId() << " " << c.getClientId() << " " << c.getObjectId() << " "
+            << c.getStartDate() << " " << c.getDuration() << " " << c.getAmount() << "|"
+            << c.getWorkType() << "|" << c.getStatus() << "|" << c.getManager() << endl;
+        });
+    compare("", clients, "save_bench_clients.txt", [](ofstream& file, const Client& c) {
+        file << c.getId() << "|" << c.getCompanyName() << "|" << c.getContactPerson() << "|"
+            << c.getPhone() << "|" << c.getEmail() << "|" << c.getAddress() << endl;
+        });
+    compare("", objects, "save_bench_objects.txt", [](ofstream& file, const ConstructionObject& o) {
+        file << o.getId() << "|" << o.getName() << "|" << o.getAddress() << "|"
+            << o.getType() << "|" << o.getArea() << endl;
+        });
+    return 0;
+}
\ No newline at end of file
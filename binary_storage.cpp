@@ -0,0 +1,150 @@
+#include "binary_storage.h"
+#include <fstream>
+#include <cstdio>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+#ifdef _WIN32
+
+MappedFile::MappedFile() : ptr(nullptr), length(0), fileHandle(INVALID_HANDLE_VALUE), mappingHandle(nullptr) {}
+
+bool MappedFile::open(const string& path) {
+    close();
+    fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0) {
+        close();
+        return false;
+    }
+    mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mappingHandle) {
+        close();
+        return false;
+    }
+    ptr = static_cast<const char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+    if (!ptr) {
+        close();
+        return false;
+    }
+    length = static_cast<size_t>(fileSize.QuadPart);
+    return true;
+}
+
+void MappedFile::close() {
+    if (ptr) UnmapViewOfFile(ptr);
+    if (mappingHandle) CloseHandle(mappingHandle);
+    if (fileHandle != INVALID_HANDLE_VALUE) CloseHandle(fileHandle);
+    ptr = nullptr;
+    length = 0;
+    mappingHandle = nullptr;
+    fileHandle = INVALID_HANDLE_VALUE;
+}
+
+#else
+
+MappedFile::MappedFile() : ptr(nullptr), length(0), fd(-1) {}
+
+bool MappedFile::open(const string& path) {
+    close();
+    fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        close();
+        return false;
+    }
+    void* mapped = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapped == MAP_FAILED) {
+        close();
+        return false;
+    }
+    ptr = static_cast<const char*>(mapped);
+    length = static_cast<size_t>(st.st_size);
+    madvise(mapped, length, MADV_SEQUENTIAL);
+    return true;
+}
+
+void MappedFile::close() {
+    if (ptr) munmap(const_cast<char*>(ptr), length);
+    if (fd >= 0) ::close(fd);
+    ptr = nullptr;
+    length = 0;
+    fd = -1;
+}
+
+#endif
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::isBinaryStorage() const {
+    return length >= sizeof(BinaryFileHeader) && memcmp(ptr, BINARY_MAGIC, sizeof(BINARY_MAGIC)) == 0;
+}
+
+const BinaryFileHeader& MappedFile::header() const {
+    const BinaryFileHeader& h = *reinterpret_cast<const BinaryFileHeader*>(ptr);
+    if (h.version > BINARY_FORMAT_VERSION) {
+        throw runtime_error("   ");
+    }
+    //    ,      
+    uint64_t available = length - sizeof(BinaryFileHeader);
+    if (h.heapSize > available ||
+        (h.recordSize > 0 && h.recordCount > (available - h.heapSize) / h.recordSize) ||
+        (h.recordSize == 0 && h.recordCount > 0)) {
+        throw runtime_error("  :  ");
+    }
+    return h;
+}
+
+void replaceFile(const string& source, const string& target) {
+#ifdef _WIN32
+    bool replaced = MoveFileExA(source.c_str(), target.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    bool replaced = rename(source.c_str(), target.c_str()) == 0;
+#endif
+    if (!replaced) {
+        remove(source.c_str());
+        throw runtime_error("  : " + target);
+    }
+}
+
+void BinaryRecordWriter::writeTo(const string& path, uint32_t nextId) const {
+    //    :       
+    string temporary = path + ".tmp";
+    ofstream file(temporary, ios::binary | ios::out | ios::trunc);
+    if (!file.is_open()) {
+        throw runtime_error("    : " + path);
+    }
+    BinaryFileHeader h = {};
+    memcpy(h.magic, BINARY_MAGIC, sizeof(BINARY_MAGIC));
+    h.version = BINARY_FORMAT_VERSION;
+    h.recordSize = static_cast<uint32_t>(recordSize);
+    h.nextId = nextId;
+    h.recordCount = count;
+    h.heapSize = heap.size();
+    file.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    file.write(records.data(), static_cast<streamsize>(records.size()));
+    file.write(heap.data(), static_cast<streamsize>(heap.size()));
+    file.close();
+    if (!file) {
+        remove(temporary.c_str());
+        throw runtime_error("  : " + path);
+    }
+    replaceFile(temporary, path);
+}
\ No newline at end of file
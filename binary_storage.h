@@ -0,0 +1,168 @@
+#ifndef BINARY_STORAGE_H
+#define BINARY_STORAGE_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+//    :
+//   [][  ][ ]
+//        (, )   ,
+//            .
+
+const char BINARY_MAGIC[4] = { 'K', 'Z', 'D', 'B' };
+const uint32_t BINARY_FORMAT_VERSION = 3; // 2:    , 3:  -   
+
+struct BinaryFileHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t recordSize;
+    uint32_t nextId; //   ID  (0 -  )
+    uint64_t recordCount;
+    uint64_t heapSize;
+};
+
+//       
+class MappedFile {
+private:
+    const char* ptr;
+    size_t length;
+#ifdef _WIN32
+    void* fileHandle;
+    void* mappingHandle;
+#else
+    int fd;
+#endif
+
+public:
+    MappedFile();
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+    const char* data() const { return ptr; }
+    size_t size() const { return length; }
+
+    // ,       
+    bool isBinaryStorage() const;
+    const BinaryFileHeader& header() const;
+};
+
+//       
+class BinaryRecordWriter {
+private:
+    std::vector<char> records;
+    std::string heap;
+    size_t recordStart;
+    size_t recordSize;
+    uint64_t count;
+
+    void put(const void* value, size_t size) {
+        const char* bytes = static_cast<const char*>(value);
+        records.insert(records.end(), bytes, bytes + size);
+    }
+
+public:
+    BinaryRecordWriter() : recordStart(0), recordSize(0), count(0) {}
+
+    void beginRecord() {
+        recordStart = records.size();
+    }
+
+    void endRecord() {
+        size_t size = records.size() - recordStart;
+        if (count == 0) {
+            recordSize = size;
+        }
+        else if (size != recordSize) {
+            throw std::logic_error("      ");
+        }
+        count++;
+    }
+
+    void putInt32(int32_t value) { put(&value, sizeof(value)); }
+    void putInt64(int64_t value) { put(&value, sizeof(value)); }
+    void putDouble(double value) { put(&value, sizeof(value)); }
+    void putBool(bool value) { putInt32(value ? 1 : 0); }
+
+    //      32-:   4   
+    void putString(std::string_view value) {
+        if (heap.size() > std::numeric_limits<uint32_t>::max()
+            || value.size() > std::numeric_limits<uint32_t>::max() - heap.size()) {
+            throw std::runtime_error("    4 ");
+        }
+        uint32_t offset = static_cast<uint32_t>(heap.size());
+        uint32_t size = static_cast<uint32_t>(value.size());
+        heap.append(value.data(), value.size());
+        put(&offset, sizeof(offset));
+        put(&size, sizeof(size));
+    }
+
+    //  ,      
+    void writeTo(const std::string& path, uint32_t nextId = 0) const;
+};
+
+//   target  source (source  )
+void replaceFile(const std::string& source, const std::string& target);
+
+//        .   
+//     :       
+class BinaryRecordReader {
+private:
+    const char* cursor;
+    const char* end;
+    const char* heap;
+    uint64_t heapSize;
+    uint32_t formatVersion;
+
+    template<typename V>
+    V get() {
+        if (static_cast<size_t>(end - cursor) < sizeof(V)) {
+            throw std::runtime_error("  :    ");
+        }
+        V value;
+        std::memcpy(&value, cursor, sizeof(V));
+        cursor += sizeof(V);
+        return value;
+    }
+
+public:
+    BinaryRecordReader(const char* record, size_t recordSize, const char* heap, uint64_t heapSize,
+        uint32_t formatVersion = BINARY_FORMAT_VERSION)
+        : cursor(record), end(record + recordSize), heap(heap), heapSize(heapSize), formatVersion(formatVersion) {
+    }
+
+    //   ,    
+    uint32_t version() const { return formatVersion; }
+
+    //    ;       
+    bool atEnd() const { return cursor == end; }
+
+    int32_t getInt32() { return get<int32_t>(); }
+    int64_t getInt64() { return get<int64_t>(); }
+    double getDouble() { return get<double>(); }
+    bool getBool() { return get<int32_t>() != 0; }
+
+    std::string getString() {
+        return std::string(getStringView());
+    }
+
+    //     ,  
+    std::string_view getStringView() {
+        uint32_t offset = get<uint32_t>();
+        uint32_t size = get<uint32_t>();
+        if (static_cast<uint64_t>(offset) + size > heapSize) {
+            throw std::runtime_error("  :    ");
+        }
+        return std::string_view(heap + offset, size);
+    }
+};
+
+#endif // BINARY_STORAGE_H
\ No newline at end of file
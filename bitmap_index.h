@@ -0,0 +1,88 @@
+#ifndef BITMAP_INDEX_H
+#define BITMAP_INDEX_H
+
+#include "contracts.h"
+#include "roaring_bitmap.h"
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <functional>
+
+//         (,  ,  ):
+//       ID .  
+//    : &, |, andNot.
+template<typename T>
+class ValueBitmapIndex : public RepositoryIndex<T> {
+public:
+    //  ID      (,   )
+    virtual const RoaringBitmap& bitmap(const std::string& value) const = 0;
+    //  ID  :    " ,  ..."
+    virtual const RoaringBitmap& all() const = 0;
+};
+
+template<typename T, typename Getter>
+class BitmapIndex : public ValueBitmapIndex<T> {
+private:
+    Getter getter;
+    std::unordered_map<std::string, RoaringBitmap> bitmaps;
+    RoaringBitmap everything;
+
+    void removeFrom(const std::string& value, uint32_t id) {
+        auto it = bitmaps.find(value);
+        if (it == bitmaps.end()) return;
+        it->second.remove(id);
+        if (it->second.empty()) {
+            bitmaps.erase(it);
+        }
+    }
+
+public:
+    explicit BitmapIndex(Getter getter) : getter(getter) {}
+
+    void onStore(const T* previous, const T& item) override {
+        uint32_t id = static_cast<uint32_t>(item.getId());
+        std::string value(std::invoke(getter, item));
+        if (previous) {
+            std::string oldValue(std::invoke(getter, *previous));
+            if (oldValue == value) {
+                return;
+            }
+            removeFrom(oldValue, id);
+        }
+        bitmaps[value].add(id);
+        everything.add(id);
+    }
+
+    void onErase(const T& item) override {
+        uint32_t id = static_cast<uint32_t>(item.getId());
+        removeFrom(std::string(std::invoke(getter, item)), id);
+        everything.remove(id);
+    }
+
+    void onClear() override {
+        bitmaps.clear();
+        everything.clear();
+    }
+
+    std::string_view fieldName() const override {
+        return nameOfField(getter);
+    }
+
+    const RoaringBitmap& bitmap(const std::string& value) const override {
+        static const RoaringBitmap none;
+        auto it = bitmaps.find(value);
+        return it != bitmaps.end() ? it->second : none;
+    }
+
+    const RoaringBitmap& all() const override {
+        return everything;
+    }
+};
+
+//  : makeBitmapIndex<Contract>(&Contract::getStatus)
+template<typename T, typename Getter>
+std::shared_ptr<BitmapIndex<T, Getter>> makeBitmapIndex(Getter getter) {
+    return std::make_shared<BitmapIndex<T, Getter>>(getter);
+}
+
+#endif // BITMAP_INDEX_H
\ No newline at end of file
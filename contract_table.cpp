@@ -0,0 +1,174 @@
+#include "contract_table.h"
+#include <bitset>
+#include <limits>
+#include <stdexcept>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define CONTRACT_TABLE_SSE2
+#endif
+
+using namespace std;
+
+uint16_t Dictionary::encode(const string& value) {
+    auto it = codes.find(value);
+    if (it != codes.end()) {
+        return it->second;
+    }
+    if (values.size() > numeric_limits<uint16_t>::max()) {
+        throw runtime_error("   :  65536  ");
+    }
+    uint16_t code = static_cast<uint16_t>(values.size());
+    values.push_back(value);
+    codes.emplace(value, code);
+    return code;
+}
+
+int Dictionary::find(const string& value) const {
+    auto it = codes.find(value);
+    return it != codes.end() ? it->second : npos;
+}
+
+const string& Dictionary::decode(uint16_t code) const {
+    return values[code];
+}
+
+void ContractTable::onStore(const Contract* previous, const Contract& contract) {
+    //     :   ,   
+    uint16_t status = statuses.encode(contract.getStatus());
+    uint16_t workType = workTypes.encode(contract.getWorkType());
+    size_t row = previous ? rowOf.find(contract.getId()) : IdIndex::npos;
+    if (row == IdIndex::npos) {
+        row = ids.size();
+        rowOf.insert(contract.getId(), row);
+        ids.push_back(contract.getId());
+        clientIds.push_back(0);
+        objectIds.push_back(0);
+        startDays.push_back(0);
+        durations.push_back(0);
+        amounts.push_back(0);
+        statusCodes.push_back(0);
+        workTypeCodes.push_back(0);
+    }
+    clientIds[row] = contract.getClientId();
+    objectIds[row] = contract.getObjectId();
+    startDays[row] = contract.getStartDate().toDayNumber();
+    durations[row] = contract.getDuration();
+    amounts[row] = contract.getAmount().minorUnits();
+    statusCodes[row] = status;
+    workTypeCodes[row] = workType;
+}
+
+void ContractTable::onErase(const Contract& contract) {
+    int id = contract.getId();
+    size_t row = rowOf.find(id);
+    if (row == IdIndex::npos) {
+        return;
+    }
+    size_t last = ids.size() - 1;
+    if (row != last) {
+        ids[row] = ids[last];
+        clientIds[row] = clientIds[last];
+        objectIds[row] = objectIds[last];
+        startDays[row] = startDays[last];
+        durations[row] = durations[last];
+        amounts[row] = amounts[last];
+        statusCodes[row] = statusCodes[last];
+        workTypeCodes[row] = workTypeCodes[last];
+        rowOf.insert(ids[row], row);
+    }
+    ids.pop_back();
+    clientIds.pop_back();
+    objectIds.pop_back();
+    startDays.pop_back();
+    durations.pop_back();
+    amounts.pop_back();
+    statusCodes.pop_back();
+    workTypeCodes.pop_back();
+    rowOf.erase(id);
+}
+
+void ContractTable::onClear() {
+    ids.clear();
+    clientIds.clear();
+    objectIds.clear();
+    startDays.clear();
+    durations.clear();
+    amounts.clear();
+    statusCodes.clear();
+    workTypeCodes.clear();
+    rowOf.clear();
+}
+
+Money ContractTable::sumAmount() const {
+    const int64_t* a = amounts.data();
+    size_t n = amounts.size();
+    size_t i = 0;
+    int64_t sum = 0;
+#ifdef CONTRACT_TABLE_SSE2
+    __m128i acc0 = _mm_setzero_si128();
+    __m128i acc1 = _mm_setzero_si128();
+    for (; i + 4 <= n; i += 4) {
+        acc0 = _mm_add_epi64(acc0, _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)));
+        acc1 = _mm_add_epi64(acc1, _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i + 2)));
+    }
+    int64_t lanes[2];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), _mm_add_epi64(acc0, acc1));
+    sum = lanes[0] + lanes[1];
+#endif
+    for (; i < n; ++i) {
+        sum += a[i];
+    }
+    return Money::fromMinor(sum);
+}
+
+//      :  64-
+//  SSE2    ,  cmov  
+Money ContractTable::maxAmount() const {
+    int64_t result = numeric_limits<int64_t>::min();
+    for (int64_t value : amounts) {
+        result = value > result ? value : result;
+    }
+    return Money::fromMinor(result);
+}
+
+int ContractTable::maxAmountId() const {
+    if (amounts.empty()) {
+        return 0;
+    }
+    int64_t best = maxAmount().minorUnits();
+    //        ID,    
+    int bestId = numeric_limits<int>::max();
+    for (size_t i = 0; i < amounts.size(); ++i) {
+        if (amounts[i] == best && ids[i] < bestId) {
+            bestId = ids[i];
+        }
+    }
+    return bestId;
+}
+
+size_t ContractTable::countCode(const vector<uint16_t>& column, int code) {
+    if (code == Dictionary::npos) {
+        return 0;
+    }
+    const uint16_t* c = column.data();
+    size_t n = column.size();
+    size_t i = 0;
+    size_t count = 0;
+#ifdef CONTRACT_TABLE_SSE2
+    __m128i needle = _mm_set1_epi16(static_cast<short>(code));
+    for (; i + 8 <= n; i += 8) {
+        __m128i eq = _mm_cmpeq_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(c + i)), needle);
+        // movemask        16- 
+        count += bitset<16>(static_cast<unsigned>(_mm_movemask_epi8(eq))).count() / 2;
+    }
+#endif
+    for (; i < n; ++i) {
+        count += c[i] == code ? 1 : 0;
+    }
+    return count;
+}
+
+size_t ContractTable::countStatus(const string& status) const {
+    return countCode(statusCodes, statuses.find(status));
+}
\ No newline at end of file
@@ -0,0 +1,64 @@
+#ifndef CONTRACT_TABLE_H
+#define CONTRACT_TABLE_H
+
+#include "contracts.h"
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <cstdint>
+
+//       
+class Dictionary {
+private:
+    std::vector<std::string> values;
+    std::unordered_map<std::string, uint16_t> codes;
+
+public:
+    static constexpr int npos = -1;
+
+    //  ;     .   65536 
+    // ,  std::runtime_error
+    uint16_t encode(const std::string& value);
+    int find(const std::string& value) const; //   npos
+    const std::string& decode(uint16_t code) const;
+};
+
+//  (struct-of-arrays)    .
+//   Repository<Contract>       
+//  add, update  remove.
+//        :  
+//     .
+class ContractTable : public RepositoryIndex<Contract> {
+private:
+    std::vector<int> ids;
+    std::vector<int> clientIds;
+    std::vector<int> objectIds;
+    std::vector<int> startDays;
+    std::vector<int> durations;
+    std::vector<int64_t> amounts; //  , . Money
+    std::vector<uint16_t> statusCodes;
+    std::vector<uint16_t> workTypeCodes;
+    Dictionary statuses;
+    Dictionary workTypes;
+    IdIndex rowOf; //    
+
+    static size_t countCode(const std::vector<uint16_t>& column, int code);
+
+public:
+    // ,       
+    static constexpr const char* INDEX_NAME = "columns";
+
+    void onStore(const Contract* previous, const Contract& contract) override;
+    void onErase(const Contract& contract) override;
+    void onClear() override;
+
+    size_t size() const { return ids.size(); }
+
+    Money sumAmount() const;
+    Money maxAmount() const;
+    // ID      0,   
+    int maxAmountId() const;
+    size_t countStatus(const std::string& status) const;
+};
+
+#endif // CONTRACT_TABLE_H
\ No newline at end of file
@@ -1,7 +1,7 @@
 #include "contracts.h"
+#include "contract_table.h"
 #include <iostream>
 #include <fstream>
-#include <sstream>
 #include <stdexcept>
 #include <iomanip> 
 
@@ -17,22 +17,28 @@ void Entity::setId(int newId) {
     id = newId;
 }
 
+void Entity::saveToFile(ofstream& file) const {
+    //  :  ,   
+    RecordWriter writer(file, 4096);
+    writeRecord(writer);
+}
+
 //    Contract
 void Contract::setClientId(int id) { clientId = id; }
 void Contract::setObjectId(int id) { objectId = id; }
 void Contract::setStartDate(const Date& date) { startDate = date; }
 void Contract::setDuration(int duration) { this->duration = duration; }
-void Contract::setAmount(double amount) { contractAmount = amount; }
+void Contract::setAmount(Money amount) { contractAmount = amount; }
 void Contract::setWorkType(const std::string& type) { workType = type; }
 void Contract::setStatus(const std::string& status) { this->status = status; }
 void Contract::setManager(const std::string& manager) { this->manager = manager; }
 
 //    Client
-void Client::setCompanyName(const std::string& name) { companyName = name; }
-void Client::setContactPerson(const std::string& person) { contactPerson = person; }
-void Client::setPhone(const std::string& phone) { this->phone = phone; }
-void Client::setEmail(const std::string& email) { this->email = email; }
-void Client::setAddress(const std::string& address) { this->address = address; }
+void Client::setCompanyName(const std::string& name) { fields.set(COMPANY, name); }
+void Client::setContactPerson(const std::string& person) { fields.set(CONTACT, person); }
+void Client::setPhone(const std::string& phone) { fields.set(PHONE, phone); }
+void Client::setEmail(const std::string& email) { fields.set(EMAIL, email); }
+void Client::setAddress(const std::string& address) { fields.set(ADDRESS, address); }
 
 //    ConstructionObject
 void ConstructionObject::setName(const std::string& name) { objectName = name; }
@@ -63,38 +69,99 @@ string Encryption::decrypt(const string& data) {
     return result;
 }
 
-Date::Date(int d, int m, int y) : day(d), month(m), year(y) {}
-
-bool Date::operator<(const Date& other) const {
-    if (year != other.year) return year < other.year;
-    if (month != other.month) return month < other.month;
-    return day < other.day;
+bool Date::parse(string_view text, Date& out) {
+    if (text.size() != FORMATTED_SIZE || text[2] != '.' || text[5] != '.') {
+        return false;
+    }
+    //     :  '0'   0..9
+    //   ,      9 ()
+    static constexpr int DIGITS[8] = { 0, 1, 3, 4, 6, 7, 8, 9 };
+    unsigned d[8];
+    unsigned bad = 0;
+    for (int i = 0; i < 8; ++i) {
+        d[i] = static_cast<unsigned>(static_cast<unsigned char>(text[DIGITS[i]])) - '0';
+        bad |= d[i] > 9 ? 1u : 0u;
+    }
+    if (bad) {
+        return false;
+    }
+    int day = static_cast<int>(d[0] * 10 + d[1]);
+    int month = static_cast<int>(d[2] * 10 + d[3]);
+    int year = static_cast<int>(d[4] * 1000 + d[5] * 100 + d[6] * 10 + d[7]);
+    if (month < 1 || month > 12 || day < 1 || day > daysInMonth(month, year)) {
+        return false;
+    }
+    out = Date(day, month, year);
+    return true;
 }
 
-bool Date::operator==(const Date& other) const {
-    return day == other.day && month == other.month && year == other.year;
+void Date::format(char* out) const {
+    Civil c = toCivil();
+    int year = c.year < 0 ? 0 : (c.year > 9999 ? 9999 : c.year);
+    out[0] = static_cast<char>('0' + c.day / 10);
+    out[1] = static_cast<char>('0' + c.day % 10);
+    out[2] = '.';
+    out[3] = static_cast<char>('0' + c.month / 10);
+    out[4] = static_cast<char>('0' + c.month % 10);
+    out[5] = '.';
+    out[6] = static_cast<char>('0' + year / 1000);
+    out[7] = static_cast<char>('0' + year / 100 % 10);
+    out[8] = static_cast<char>('0' + year / 10 % 10);
+    out[9] = static_cast<char>('0' + year % 10);
 }
 
 string Date::toString() const {
-    stringstream ss;
-    ss << setfill('0') << setw(2) << day << "."
-        << setfill('0') << setw(2) << month << "."
-        << year;
-    return ss.str();
+    char buffer[FORMATTED_SIZE];
+    format(buffer);
+    return string(buffer, FORMATTED_SIZE);
+}
+
+void Date::saveBinary(BinaryRecordWriter& writer) const {
+    writer.putInt32(days);
+}
+
+void Date::loadBinary(BinaryRecordReader& reader) {
+    if (reader.version() < 2) {
+        //  1  ,    
+        int d = reader.getInt32();
+        int m = reader.getInt32();
+        int y = reader.getInt32();
+        days = fromCivil(d, m, y);
+        return;
+    }
+    days = reader.getInt32();
+}
+
+bool Date::parseFields(RecordParser& parser) {
+    int d, m, y;
+    if (!parser.number(d) || !parser.number(m) || !parser.number(y)) {
+        return false;
+    }
+    days = fromCivil(d, m, y);
+    return true;
+}
+
+void Date::writeFields(RecordWriter& writer) const {
+    Civil c = toCivil();
+    writer.number(c.day).put(' ').number(c.month).put(' ').number(c.year);
 }
 
 ostream& operator<<(ostream& os, const Date& date) {
-    os << date.day << " " << date.month << " " << date.year;
+    Date::Civil c = date.toCivil();
+    os << c.day << " " << c.month << " " << c.year;
     return os;
 }
 
 istream& operator>>(istream& is, Date& date) {
-    is >> date.day >> date.month >> date.year;
+    int d, m, y;
+    if (is >> d >> m >> y) {
+        date = Date(d, m, y);
+    }
     return is;
 }
 
 User::User(int id, const string& login, const string& password, bool isAdmin)
-    : Entity(id), login(login), isAdmin(isAdmin) {
+    : SchemaEntity(id), login(login), isAdmin(isAdmin) {
     setPassword(password);
 }
 
@@ -110,7 +177,7 @@ bool User::getIsAdmin() const {
     return isAdmin;
 }
 
-string User::getLogin() const {
+const string& User::getLogin() const {
     return login;
 }
 
@@ -118,75 +185,40 @@ void User::display() const {
     cout << "ID: " << id << ", : " << login << ", : " << (isAdmin ? "" : "") << endl;
 }
 
-void User::saveToFile(ofstream& file) const {
-    file << id << " " << login << " " << password << " " << isAdmin << endl;
-}
-
-void User::loadFromFile(ifstream& file) {
-    file >> id >> login >> password >> isAdmin;
-}
-
 Client::Client(int id, const string& company, const string& contact,
     const string& phone, const string& email, const string& address)
-    : Entity(id), companyName(company), contactPerson(contact),
-    phone(phone), email(email), address(address) {
+    : SchemaEntity(id) {
+    fields.assign({ company, contact, phone, email, address });
 }
 
 void Client::display() const {
-    cout << "ID: " << id << ", : " << companyName
-        << ",  : " << contactPerson << ", : " << phone << endl;
+    cout << "ID: " << id << ", : " << getCompanyName()
+        << ",  : " << getContactPerson() << ", : " << getPhone() << endl;
 }
 
-string Client::getCompanyName() const {
-    return companyName;
+string_view Client::getCompanyName() const {
+    return fields.get(COMPANY);
 }
 
-string Client::getContactPerson() const {
-    return contactPerson;
+string_view Client::getContactPerson() const {
+    return fields.get(CONTACT);
 }
 
-string Client::getPhone() const {
-    return phone;
+string_view Client::getPhone() const {
+    return fields.get(PHONE);
 }
 
-string Client::getEmail() const {
-    return email;
+string_view Client::getEmail() const {
+    return fields.get(EMAIL);
 }
 
-string Client::getAddress() const {
-    return address;
-}
-
-void Client::saveToFile(ofstream& file) const {
-    file << id << "|" << companyName << "|" << contactPerson << "|"
-        << phone << "|" << email << "|" << address << endl;
-}
-
-void Client::loadFromFile(ifstream& file) {
-    string line;
-    if (getline(file, line)) {
-        stringstream ss(line);
-        string temp;
-
-        if (!getline(ss, temp, '|')) return;
-        try {
-            id = stoi(temp);
-        }
-        catch (...) {
-            return;
-        }
-
-        if (!getline(ss, companyName, '|')) return;
-        if (!getline(ss, contactPerson, '|')) return;
-        if (!getline(ss, phone, '|')) return;
-        if (!getline(ss, email, '|')) return;
-        if (!getline(ss, address)) return;
-    }
+string_view Client::getAddress() const {
+    return fields.get(ADDRESS);
 }
 
 ConstructionObject::ConstructionObject(int id, const string& name, const string& addr,
     const string& type, double area)
-    : Entity(id), objectName(name), address(addr), objectType(type), area(area) {
+    : SchemaEntity(id), objectName(name), address(addr), objectType(type), area(area) {
 }
 
 void ConstructionObject::display() const {
@@ -202,51 +234,18 @@ string ConstructionObject::getAddress() const {
     return address;
 }
 
-string ConstructionObject::getType() const {
-    return objectType;
+const string& ConstructionObject::getType() const {
+    return objectType.str();
 }
 
 double ConstructionObject::getArea() const {
     return area;
 }
 
-void ConstructionObject::saveToFile(ofstream& file) const {
-    file << id << "|" << objectName << "|" << address << "|"
-        << objectType << "|" << area << endl;
-}
-
-void ConstructionObject::loadFromFile(ifstream& file) {
-    string line;
-    if (getline(file, line)) {
-        stringstream ss(line);
-        string temp;
-
-        if (!getline(ss, temp, '|')) return;
-        try {
-            id = stoi(temp);
-        }
-        catch (...) {
-            return;
-        }
-
-        if (!getline(ss, objectName, '|')) return;
-        if (!getline(ss, address, '|')) return;
-        if (!getline(ss, objectType, '|')) return;
-
-        if (!getline(ss, temp)) return;
-        try {
-            area = stod(temp);
-        }
-        catch (...) {
-            return;
-        }
-    }
-}
-
 Contract::Contract(int id, int clientId, int objectId, const Date& date,
-    int duration, double amount, const string& workType,
+    int duration, Money amount, const string& workType,
     const string& status, const string& manager)
-    : Entity(id), clientId(clientId), objectId(objectId), startDate(date),
+    : SchemaEntity(id), clientId(clientId), objectId(objectId), startDate(date),
     duration(duration), contractAmount(amount), workType(workType),
     status(status), manager(manager) {
 }
@@ -256,15 +255,12 @@ bool Contract::operator<(const Contract& other) const {
 }
 
 void Contract::display() const {
-    cout.unsetf(ios_base::floatfield);
-    cout << setprecision(6);
-
     cout << " : " << id
         << ", ID : " << clientId
         << ", ID : " << objectId
         << ",  : " << startDate.toString()
         << ", : " << duration << " ."
-        << ", : " << fixed << setprecision(0) << contractAmount
+        << ", : " << contractAmount
         << ",  : " << workType
         << ", : " << status
         << ", : " << manager
@@ -272,48 +268,26 @@ void Contract::display() const {
     cout << endl; //     
 }
 
-void Contract::saveToFile(ofstream& file) const {
-    file << id << " " << clientId << " " << objectId << " "
-        << startDate << " " << duration << " " << contractAmount << "|"
-        << workType << "|" << status << "|" << manager << endl;
-}
-
-void Contract::loadFromFile(ifstream& file) {
-    string line;
-    if (getline(file, line)) {
-        stringstream ss(line);
-
-        ss >> id >> clientId >> objectId >> startDate >> duration >> contractAmount;
-
-        if (ss.fail()) return;
-
-        size_t pipePos = line.find('|', ss.tellg());
-        if (pipePos == string::npos) return;
-
-        ss.seekg(pipePos + 1);
-
-        if (!getline(ss, workType, '|')) return;
-        if (!getline(ss, status, '|')) return;
-        if (!getline(ss, manager)) return;
-    }
-}
-
-double Contract::getAmount() const {
+Money Contract::getAmount() const {
     return contractAmount;
 }
 
-string Contract::getStatus() const {
-    return status;
+const string& Contract::getStatus() const {
+    return status.str();
 }
 
-string Contract::getWorkType() const {
-    return workType;
+const string& Contract::getWorkType() const {
+    return workType.str();
 }
 
-string Contract::getManager() const {
+const string& Contract::getManager() const {
     return manager;
 }
 
+bool Contract::hasStatus(const InternedString& value) const {
+    return status == value;
+}
+
 Date Contract::getStartDate() const {
     return startDate;
 }
@@ -334,32 +308,33 @@ void ReportGenerator::generateContractsReport(const Repository<Contract>& contra
     const Repository<Client>& clients,
     const Repository<ConstructionObject>& objects) {
     cout << "\n==========    ==========\n";
-    auto allContracts = contracts.findAll();
-
-    double totalAmount = 0;
-    int activeCount = 0;
+    //     ,   
+    const ContractTable* table = contracts.getIndex<ContractTable>(ContractTable::INDEX_NAME);
+    Money totalAmount = table ? table->sumAmount() : Money();
+    size_t activeCount = table ? table->countStatus(" ") : 0;
+    const InternedString active(" ");
 
     cout.unsetf(ios_base::floatfield);
     cout << setprecision(6);
 
-    for (const auto& contract : allContracts) {
-        totalAmount += contract->getAmount();
-        if (contract->getStatus() == " ") activeCount++;
-
-        auto client = clients.find(contract->getClientId());
-        auto object = objects.find(contract->getObjectId());
+    contracts.join(clients, &Contract::getClientId, objects, &Contract::getObjectId,
+        [&](const Contract& contract, const Client* client, const ConstructionObject* object) {
+                if (!table) {
+                    totalAmount += contract.getAmount();
+                    if (contract.hasStatus(active)) activeCount++;
+                }
 
-        cout << " " << contract->getId() << ": "
-            << (client ? client->getCompanyName() : "N/A") << " - "
-            << (object ? object->getName() : "N/A") << " - "
-            << fixed << setprecision(0) << contract->getAmount() << " . - "
-            << contract->getStatus() << endl;
-    }
+                cout << " " << contract.getId() << ": "
+                    << (client ? client->getCompanyName() : "N/A") << " - "
+                    << (object ? object->getName() : "N/A") << " - "
+                    << contract.getAmount() << " . - "
+                    << contract.getStatus() << endl;
+                });
 
     cout << "\n:\n";
-    cout << " : " << allContracts.size() << endl;
+    cout << " : " << contracts.size() << endl;
     cout << "  : " << activeCount << endl;
-    cout << " : " << fixed << setprecision(0) << totalAmount << " .\n";
+    cout << " : " << totalAmount << " .\n";
     cout << "==========================================\n";
 
     cout.unsetf(ios_base::floatfield);
@@ -8,6 +8,24 @@
 #include <fstream>
 #include <algorithm>
 #include <functional>
+#include <stdexcept>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include <limits>
+#include <cstdio>
+#include "id_index.h"
+#include "binary_storage.h"
+#include "record_parser.h"
+#include "record_writer.h"
+#include "thread_pool.h"
+#include "slot_map.h"
+#include "record_view.h"
+#include "money.h"
+#include "intern_table.h"
+#include "packed_strings.h"
+#include "field_schema.h"
+#include "parallel_sort.h"
 
 //     ( )
 #define KEY 3
@@ -26,26 +44,147 @@ public:
     int getId() const;
     void setId(int newId);
     virtual void display() const = 0;
-    virtual void saveToFile(std::ofstream& file) const = 0;
+    //        
+    virtual void writeRecord(RecordWriter& writer) const = 0;
+    void saveToFile(std::ofstream& file) const;
     virtual void loadFromFile(std::ifstream& file) = 0;
+    //    ; false,   
+    virtual bool parseRecord(std::string_view line) = 0;
+    virtual void saveBinary(BinaryRecordWriter& writer) const = 0;
+    virtual void loadBinary(BinaryRecordReader& reader) = 0;
     virtual ~Entity() = default;
 };
 
+//     -   01.01.1970,  
+//        int,    4 .
+// ,       ( Howard Hinnant).
 class Date {
 private:
-    int day;
-    int month;
-    int year;
+    int32_t days;
+
+    static constexpr int32_t fromCivil(int d, int m, int y) {
+        y -= m <= 2 ? 1 : 0;
+        int era = (y >= 0 ? y : y - 399) / 400;
+        int yoe = y - era * 400;
+        int doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+        int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+        return era * 146097 + doe - 719468;
+    }
+
 public:
-    Date(int d = 1, int m = 1, int y = 2000);
-    bool operator<(const Date& other) const;
-    bool operator==(const Date& other) const;
+    struct Civil {
+        int day;
+        int month;
+        int year;
+    };
+
+    constexpr Date(int d = 1, int m = 1, int y = 2000) : days(fromCivil(d, m, y)) {}
+
+    static constexpr Date fromDayNumber(int32_t dayNumber) {
+        Date date;
+        date.days = dayNumber;
+        return date;
+    }
+
+    constexpr Civil toCivil() const {
+        int z = days + 719468;
+        int era = (z >= 0 ? z : z - 146096) / 146097;
+        int doe = z - era * 146097;
+        int yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+        int doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+        int mp = (5 * doy + 2) / 153;
+        int d = doy - (153 * mp + 2) / 5 + 1;
+        int m = mp < 10 ? mp + 3 : mp - 9;
+        return Civil{ d, m, yoe + era * 400 + (m <= 2 ? 1 : 0) };
+    }
+
+    constexpr int getDay() const { return toCivil().day; }
+    constexpr int getMonth() const { return toCivil().month; }
+    constexpr int getYear() const { return toCivil().year; }
+
+    //    01.01.1970 (       )
+    constexpr int toDayNumber() const { return days; }
+
+    constexpr bool operator<(const Date& other) const { return days < other.days; }
+    constexpr bool operator==(const Date& other) const { return days == other.days; }
+    constexpr bool operator!=(const Date& other) const { return days != other.days; }
+
+    constexpr Date addDays(int count) const { return fromDayNumber(days + count); }
+    //    other    (,  other )
+    constexpr int operator-(const Date& other) const { return days - other.days; }
+
+    static constexpr bool isLeapYear(int y) {
+        return (y % 4 == 0 && y % 100 != 0) || y % 400 == 0;
+    }
+
+    static constexpr int daysInMonth(int m, int y) {
+        return m == 2 ? (isLeapYear(y) ? 29 : 28) : 30 + ((m + (m > 7 ? 1 : 0)) & 1);
+    }
+
+    //     ".."    
+    static bool parse(std::string_view text, Date& out);
+    //    ".."; out   FORMATTED_SIZE 
+    static constexpr size_t FORMATTED_SIZE = 10;
+    void format(char* out) const;
     std::string toString() const;
+    void saveBinary(BinaryRecordWriter& writer) const;
+    void loadBinary(BinaryRecordReader& reader);
+    bool parseFields(RecordParser& parser);
+    //  "  "  ,    parseFields
+    void writeFields(RecordWriter& writer) const;
     friend std::ostream& operator<<(std::ostream& os, const Date& date);
     friend std::istream& operator>>(std::istream& is, Date& date);
 };
 
-class User : public Entity {
+template<>
+struct FieldCodec<Date> {
+    static void write(RecordWriter& writer, const Date& value, char) { value.writeFields(writer); }
+    static bool parse(RecordParser& parser, char delim, bool last, Date& value) {
+        return value.parseFields(parser) && expectFieldDelim(parser, delim, last);
+    }
+    static void save(BinaryRecordWriter& writer, const Date& value) { value.saveBinary(writer); }
+    static void load(BinaryRecordReader& reader, Date& value) { value.loadBinary(reader); }
+};
+
+template<>
+struct RadixKey<Date> {
+    static constexpr bool SUPPORTED = true;
+    static uint64_t encode(const Date& value) { return RadixKey<int>::encode(value.toDayNumber()); }
+};
+
+// ,     Derived::SCHEMA (. field_schema.h):
+//           
+template<typename Derived>
+class SchemaEntity : public Entity {
+public:
+    using Entity::Entity;
+
+    void writeRecord(RecordWriter& writer) const override {
+        Derived::SCHEMA.write(static_cast<const Derived&>(*this), writer);
+    }
+
+    void loadFromFile(std::ifstream& file) override {
+        std::string line;
+        if (std::getline(file, line)) {
+            parseRecord(line);
+        }
+    }
+
+    bool parseRecord(std::string_view line) override {
+        RecordParser parser(line);
+        return Derived::SCHEMA.parse(static_cast<Derived&>(*this), parser);
+    }
+
+    void saveBinary(BinaryRecordWriter& writer) const override {
+        Derived::SCHEMA.save(static_cast<const Derived&>(*this), writer);
+    }
+
+    void loadBinary(BinaryRecordReader& reader) override {
+        Derived::SCHEMA.load(static_cast<Derived&>(*this), reader);
+    }
+};
+
+class User : public SchemaEntity<User> {
 private:
     std::string login;
     std::string password; // 
@@ -55,29 +194,34 @@ public:
     void setPassword(const std::string& pwd);
     bool checkPassword(const std::string& pwd) const;
     bool getIsAdmin() const;
-    std::string getLogin() const;
+    const std::string& getLogin() const;
     void display() const override;
-    void saveToFile(std::ofstream& file) const override;
-    void loadFromFile(std::ifstream& file) override;
+
+    //  : "id   _"
+    static constexpr auto ID = makeField("id", &User::id, ' ');
+    static constexpr auto LOGIN = makeField("login", &User::login, ' ');
+    static constexpr auto PASSWORD = makeField("password", &User::password, ' ');
+    static constexpr auto IS_ADMIN = makeField("isAdmin", &User::isAdmin);
+    static constexpr auto SCHEMA = makeSchema(ID, LOGIN, PASSWORD, IS_ADMIN);
 };
 
-class Client : public Entity {
+class Client : public SchemaEntity<Client> {
 private:
-    std::string companyName;
-    std::string contactPerson;
-    std::string phone;
-    std::string email;
-    std::string address;
+    //         
+    enum Field { COMPANY, CONTACT, PHONE, EMAIL, ADDRESS, FIELD_COUNT };
+    PackedStrings<FIELD_COUNT> fields;
 public:
     Client(int id = 0, const std::string& company = "", const std::string& contact = "",
         const std::string& phone = "", const std::string& email = "", const std::string& address = "");
 
-    // 
-    std::string getCompanyName() const;
-    std::string getContactPerson() const;
-    std::string getPhone() const;
-    std::string getEmail() const;
-    std::string getAddress() const;
+    //        :  
+    //  ,      .   
+    // ,  : std::string(client.getEmail())
+    std::string_view getCompanyName() const;
+    std::string_view getContactPerson() const;
+    std::string_view getPhone() const;
+    std::string_view getEmail() const;
+    std::string_view getAddress() const;
 
     //   :
     void setCompanyName(const std::string& name);
@@ -87,15 +231,20 @@ public:
     void setAddress(const std::string& address);
 
     void display() const override;
-    void saveToFile(std::ofstream& file) const override;
-    void loadFromFile(std::ifstream& file) override;
+
+    //  : "id||||email|"
+    static constexpr auto ID = makeField("id", &Client::id);
+    static constexpr auto TEXT_FIELDS = makeField("company|contact|phone|email|address", &Client::fields);
+    static constexpr auto SCHEMA = makeSchema(ID, TEXT_FIELDS);
+    //       
+    static constexpr auto COMPANY_NAME = makeField("company", &Client::getCompanyName);
 };
 
-class ConstructionObject : public Entity {
+class ConstructionObject : public SchemaEntity<ConstructionObject> {
 private:
     std::string objectName;
     std::string address;
-    std::string objectType;
+    InternedString objectType;
     double area;
 public:
     ConstructionObject(int id = 0, const std::string& name = "", const std::string& addr = "",
@@ -104,7 +253,7 @@ public:
     // 
     std::string getName() const;
     std::string getAddress() const;
-    std::string getType() const;
+    const std::string& getType() const;
     double getArea() const;
 
     //   :
@@ -114,32 +263,43 @@ public:
     void setArea(double area);
 
     void display() const override;
-    void saveToFile(std::ofstream& file) const override;
-    void loadFromFile(std::ifstream& file) override;
+
+    //  : "id||||"
+    static constexpr auto ID = makeField("id", &ConstructionObject::id);
+    static constexpr auto NAME = makeField("name", &ConstructionObject::objectName);
+    static constexpr auto ADDRESS = makeField("address", &ConstructionObject::address);
+    static constexpr auto TYPE = makeField("type", &ConstructionObject::objectType);
+    static constexpr auto AREA = makeField("area", &ConstructionObject::area);
+    static constexpr auto SCHEMA = makeSchema(ID, NAME, ADDRESS, TYPE, AREA);
 };
 
-class Contract : public Entity {
+class Contract : public SchemaEntity<Contract> {
 private:
     int clientId;
     int objectId;
     Date startDate;
     int duration;
-    double contractAmount;
-    std::string workType;
-    std::string status;
+    Money contractAmount;
+    //          .
+    //   -  :  ,     ,
+    //     ,    
+    InternedString workType;
+    InternedString status;
     std::string manager;
 public:
     Contract(int id = 0, int clientId = 0, int objectId = 0, const Date& date = Date(),
-        int duration = 0, double amount = 0.0, const std::string& workType = "",
+        int duration = 0, Money amount = Money(), const std::string& workType = "",
         const std::string& status = "", const std::string& manager = "");
 
     bool operator<(const Contract& other) const;
 
     // 
-    double getAmount() const;
-    std::string getStatus() const;
-    std::string getWorkType() const;
-    std::string getManager() const;
+    Money getAmount() const;
+    const std::string& getStatus() const;
+    const std::string& getWorkType() const;
+    const std::string& getManager() const;
+    //    ,   
+    bool hasStatus(const InternedString& value) const;
     Date getStartDate() const;
     int getClientId() const;
     int getObjectId() const;
@@ -150,101 +310,888 @@ public:
     void setObjectId(int id);
     void setStartDate(const Date& date);
     void setDuration(int duration);
-    void setAmount(double amount);
+    void setAmount(Money amount);
     void setWorkType(const std::string& type);
     void setStatus(const std::string& status);
     void setManager(const std::string& manager);
 
     void display() const override;
-    void saveToFile(std::ofstream& file) const override;
-    void loadFromFile(std::ifstream& file) override;
+
+    //  : "id       |_||"
+    static constexpr auto ID = makeField("id", &Contract::id, ' ');
+    static constexpr auto CLIENT_ID = makeField("clientId", &Contract::clientId, ' ');
+    static constexpr auto OBJECT_ID = makeField("objectId", &Contract::objectId, ' ');
+    static constexpr auto START_DATE = makeField("startDate", &Contract::startDate, ' ');
+    static constexpr auto DURATION = makeField("duration", &Contract::duration, ' ');
+    static constexpr auto AMOUNT = makeField("amount", &Contract::contractAmount);
+    static constexpr auto WORK_TYPE = makeField("workType", &Contract::workType);
+    static constexpr auto STATUS = makeField("status", &Contract::status);
+    static constexpr auto MANAGER = makeField("manager", &Contract::manager);
+    static constexpr auto SCHEMA = makeSchema(ID, CLIENT_ID, OBJECT_ID, START_DATE, DURATION,
+        AMOUNT, WORK_TYPE, STATUS, MANAGER);
+};
+
+template<typename T>
+class Repository;
+
+//   ,    
+//   :   ,    .
+//       ,    
+//   ,      
+template<typename T>
+class RepositoryIndex {
+public:
+    virtual ~RepositoryIndex() = default;
+    // previous -     ID    nullptr   .
+    // ,     ,  ,  :
+    //    ,    
+    virtual void onStore(const T* previous, const T& item) = 0;
+    virtual void onErase(const T& item) = 0; //    
+    virtual void onClear() = 0;
+    //   ; ,     (,
+    //    ),    repo
+    virtual void onAttach(const Repository<T>& repo) { (void)repo; }
+    //   ,     (,   
+    //   );       
+    virtual std::string_view fieldName() const { return std::string_view(); }
+};
+
+// ,       . ,   string_view,
+//         ,    .
+template<typename K>
+struct IndexKey {
+    using type = K;
+};
+
+template<>
+struct IndexKey<std::string_view> {
+    using type = std::string;
+};
+
+//      
+template<>
+struct IndexKey<InternedString> {
+    using type = std::string;
+};
+
+template<typename T, typename Getter>
+using IndexKeyOf = typename IndexKey<std::decay_t<std::invoke_result_t<Getter, const T&>>>::type;
+
+// ,    ( , . sorted_view.h)
+template<typename T>
+class OrderedIndex : public RepositoryIndex<T> {
+public:
+    virtual size_t size() const = 0;
+    // ID     [offset, offset + count)
+    virtual std::vector<int> page(size_t offset, size_t count) const = 0;
+    //     
+    virtual bool descending() const { return false; }
+};
+
+//  :   -> ID  (. secondary_index.h)
+template<typename T, typename Key>
+class SecondaryIndex : public RepositoryIndex<T> {
+public:
+    // ID       
+    virtual const std::vector<int>& lookup(const Key& key) const = 0;
+    virtual size_t count(const Key& key) const = 0;
+};
+
+//         (. trigram_index.h)
+template<typename T>
+class TextIndex : public RepositoryIndex<T> {
+public:
+    // ID ,    pattern,  
+    virtual std::vector<int> match(const std::string& pattern) const = 0;
+    //       
+    virtual size_t estimateMatches(const std::string& pattern) const = 0;
+};
+
+//     [,  + )    01.01.1970
+// (. interval_index.h); fieldName -   
+template<typename T>
+class PeriodIndex : public RepositoryIndex<T> {
+public:
+    // ID ,     [from, to)
+    virtual std::vector<int> overlapping(int from, int to) const = 0;
+    //      
+    virtual size_t countOverlapping(int from, int to) const = 0;
+};
+
+//        (. SortedView)
+template<typename T, typename Key>
+class RangeIndex : public OrderedIndex<T> {
+public:
+    // ID     lo  hi    
+    virtual std::vector<int> rangeIds(const Key& lo, const Key& hi) const = 0;
+    //      , O(log N)
+    virtual size_t countRange(const Key& lo, const Key& hi) const = 0;
+};
+
+// ,         (, )
+template<typename T>
+class PartitionedIndex : public RepositoryIndex<T> {
+public:
+    virtual std::vector<int> page(const std::string& group, size_t offset, size_t count) const = 0;
 };
 
 template<typename T>
 class Repository {
+public:
+    enum class StorageFormat { Text, Binary };
+
 private:
-    std::vector<std::shared_ptr<T>> data;
+    //    ;   ID  
+    SlotMap<T> data;
+    IdIndex index;
     std::string filename;
+    //       (. revision)
+    size_t changes = 0;
+
+    //  :     filename + ".log",
+    //        
+    bool journaling = false;
+    size_t compactThreshold = 0;
+    size_t journalRecords = 0;
+    std::vector<std::pair<char, int>> pendingOps; // '+' - /, '-' - 
+    //  nextId,        
+    int journaledNextId = 1;
+
+    StorageFormat format = StorageFormat::Text;
+
+    //  ID: nextId   ID,       .
+    //     ,  ID    
+    //    ,      
+    int nextId = 1;
+    bool reuseIds = false;
+    std::vector<int> freeIds; //  ID (  reuseIds)
+
+    std::vector<std::pair<std::string, std::shared_ptr<RepositoryIndex<T>>>> indexes;
+
+    //      
+    static constexpr size_t PARALLEL_LOAD_MIN_BYTES = 4 << 20;
+    //        ID.  
+    //     ,     
+    static constexpr std::string_view NEXT_ID_MARKER = "#nextId ";
+
+    template<typename Key>
+    const RangeIndex<T, Key>* rangeIndex(const std::string& viewName) const {
+        const RangeIndex<T, Key>* view = getIndex<RangeIndex<T, Key>>(viewName);
+        if (!view) {
+            throw std::runtime_error("  : " + viewName);
+        }
+        return view;
+    }
+
+    T* lookup(int id) const {
+        size_t packed = index.find(id);
+        return packed != IdIndex::npos ? data.get(Handle::unpack(packed)) : nullptr;
+    }
+
+    void insertItem(T&& item) {
+        //    ,          
+        if (!IdIndex::accepts(item.getId())) {
+            throw std::runtime_error(" ID : " + std::to_string(item.getId()));
+        }
+        T* existing = lookup(item.getId());
+        size_t updated = 0;
+        try {
+            for (; updated < indexes.size(); ++updated) {
+                indexes[updated].second->onStore(existing, item);
+            }
+        }
+        catch (...) {
+            //     (,    ):
+            //       
+            for (size_t i = 0; i < updated; ++i) {
+                if (existing) {
+                    indexes[i].second->onStore(&item, *existing);
+                }
+                else {
+                    indexes[i].second->onErase(item);
+                }
+            }
+            throw;
+        }
+        changes++;
+        if (existing) {
+            *existing = std::move(item);
+            return;
+        }
+        int id = item.getId();
+        if (id >= nextId) {
+            nextId = id + 1;
+        }
+        index.insert(id, data.emplace(std::move(item)).pack());
+    }
+
+    bool eraseItem(int id) {
+        size_t packed = index.find(id);
+        if (packed == IdIndex::npos) {
+            return false;
+        }
+        Handle handle = Handle::unpack(packed);
+        for (const auto& entry : indexes) {
+            entry.second->onErase(*data.get(handle));
+        }
+        index.erase(id);
+        data.erase(handle);
+        changes++;
+        if (reuseIds) {
+            freeIds.push_back(id);
+        }
+        return true;
+    }
+
+    //  ID  ,      
+    void collectFreeIds() {
+        freeIds.clear();
+        for (int id = nextId - 1; id >= 1; --id) {
+            if (index.find(id) == IdIndex::npos) {
+                freeIds.push_back(id);
+            }
+        }
+    }
+
+    std::string journalFilename() const {
+        return filename + ".log";
+    }
+
+    void writeTextFile(const std::string& path) const {
+        //         ,
+        //        
+        std::string temporary = path + ".tmp";
+        std::ofstream file(temporary, std::ios::binary | std::ios::out | std::ios::trunc);
+        if (!file.is_open()) {
+            throw std::runtime_error("    : " + path);
+        }
+        {
+            RecordWriter writer(file);
+            writer.text(NEXT_ID_MARKER).number(nextId).endRecord();
+            data.forEach([&writer](const T& item) {
+                item.writeRecord(writer);
+                });
+        }
+        file.close();
+        if (!file) {
+            std::remove(temporary.c_str());
+            throw std::runtime_error("  : " + path);
+        }
+        replaceFile(temporary, path);
+    }
+
+    void writeBinaryFile(const std::string& path) const {
+        BinaryRecordWriter writer;
+        data.forEach([&writer](const T& item) {
+            writer.beginRecord();
+            item.saveBinary(writer);
+            writer.endRecord();
+            });
+        writer.writeTo(path, static_cast<uint32_t>(nextId));
+    }
+
+    void writeSnapshot() const {
+        if (format == StorageFormat::Binary) {
+            writeBinaryFile(filename);
+        }
+        else {
+            writeTextFile(filename);
+        }
+    }
+
+    void clearData() {
+        data.clear();
+        index.clear();
+        changes++;
+        nextId = 1;
+        freeIds.clear();
+        for (const auto& entry : indexes) {
+            entry.second->onClear();
+        }
+    }
+
+    static void parseTextRange(const char* begin, const char* end, std::vector<T>& out) {
+        while (begin < end) {
+            const char* newline = static_cast<const char*>(std::memchr(begin, '\n', static_cast<size_t>(end - begin)));
+            const char* lineEnd = newline ? newline : end;
+            std::string_view line(begin, static_cast<size_t>(lineEnd - begin));
+            if (!line.empty() && line != "\r") {
+                out.emplace_back();
+                if (!out.back().parseRecord(line)) {
+                    out.pop_back();
+                }
+            }
+            begin = lineEnd + 1;
+        }
+    }
+
+    //        ,  
+    //   ,        
+    void readTextBuffer(const char* text, size_t size) {
+        std::string_view head(text, std::min(size, NEXT_ID_MARKER.size()));
+        if (head == NEXT_ID_MARKER) {
+            const char* newline = static_cast<const char*>(std::memchr(text, '\n', size));
+            size_t headerSize = newline ? static_cast<size_t>(newline - text) + 1 : size;
+            RecordParser parser(std::string_view(text + head.size(), headerSize - head.size()));
+            int mark = 0;
+            if (parser.number(mark) && mark > nextId) {
+                nextId = mark;
+            }
+            text += headerSize;
+            size -= headerSize;
+        }
+
+        ThreadPool& pool = ThreadPool::instance();
+        size_t chunks = size >= PARALLEL_LOAD_MIN_BYTES ? pool.concurrency() * 4 : 1;
+        std::vector<size_t> bounds(chunks + 1, size);
+        bounds[0] = 0;
+        for (size_t k = 1; k < chunks; ++k) {
+            size_t pos = std::max(size / chunks * k, bounds[k - 1]);
+            const char* newline = static_cast<const char*>(std::memchr(text + pos, '\n', size - pos));
+            bounds[k] = newline ? static_cast<size_t>(newline - text) + 1 : size;
+        }
+
+        std::vector<std::vector<T>> parts(chunks);
+        pool.parallelFor(chunks, [&](size_t k) {
+            parseTextRange(text + bounds[k], text + bounds[k + 1], parts[k]);
+            });
+
+        size_t total = 0;
+        for (const auto& part : parts) {
+            total += part.size();
+        }
+        data.reserve(total);
+        index.reserve(total);
+        for (auto& part : parts) {
+            for (auto& item : part) {
+                insertItem(std::move(item));
+            }
+        }
+    }
+
+    //      ,   
+    void readBinaryFile(const MappedFile& mapped) {
+        const BinaryFileHeader& header = mapped.header();
+        if (static_cast<int64_t>(header.nextId) > nextId) {
+            nextId = static_cast<int>(header.nextId);
+        }
+        const char* records = mapped.data() + sizeof(BinaryFileHeader);
+        const char* heap = records + header.recordCount * header.recordSize;
+        data.reserve(static_cast<size_t>(header.recordCount));
+        index.reserve(static_cast<size_t>(header.recordCount));
+        for (uint64_t i = 0; i < header.recordCount; ++i) {
+            BinaryRecordReader reader(records + i * header.recordSize, header.recordSize, heap, header.heapSize, header.version);
+            T item;
+            item.loadBinary(reader);
+            if (!reader.atEnd()) {
+                throw std::runtime_error("  :      : " + filename);
+            }
+            insertItem(std::move(item));
+        }
+    }
+
+    void appendJournal() {
+        std::ofstream file(journalFilename(), std::ios::binary | std::ios::out | std::ios::app);
+        if (!file.is_open()) {
+            throw std::runtime_error("    : " + journalFilename());
+        }
+        {
+            RecordWriter writer(file);
+            for (const auto& op : pendingOps) {
+                if (op.first == '+') {
+                    const T* item = lookup(op.second);
+                    if (!item) continue; //       
+                    writer.text("+ ");
+                    item->writeRecord(writer);
+                    journaledNextId = std::max(journaledNextId, op.second + 1);
+                }
+                else {
+                    writer.text("- ").number(op.second).endRecord();
+                }
+                journalRecords++;
+            }
+            // ID ,     ,  ,   ,
+            //     :      
+            if (nextId > journaledNextId) {
+                writer.text(NEXT_ID_MARKER).number(nextId).endRecord();
+                journaledNextId = nextId;
+                journalRecords++;
+            }
+        }
+        file.close();
+    }
+
+    //  ; false,        
+    // (    )
+    bool replayJournal() {
+        std::ifstream file(journalFilename(), std::ios::binary | std::ios::in);
+        if (!file.is_open()) return true;
+        LineReader reader(file);
+        std::string_view line;
+        while (reader.next(line)) {
+            //       - ,  
+            if (!reader.lineComplete()) return false;
+            if (line.substr(0, NEXT_ID_MARKER.size()) == NEXT_ID_MARKER) {
+                RecordParser parser(line.substr(NEXT_ID_MARKER.size()));
+                int mark = 0;
+                if (!parser.number(mark)) return false;
+                nextId = std::max(nextId, mark);
+                journalRecords++;
+                continue;
+            }
+            if (line.size() < 2 || line[1] != ' ') return false;
+            std::string_view payload = line.substr(2);
+            if (line[0] == '+') {
+                T item;
+                if (!item.parseRecord(payload)) return false;
+                insertItem(std::move(item));
+            }
+            else if (line[0] == '-') {
+                RecordParser parser(payload);
+                int id;
+                if (!parser.number(id)) return false;
+                eraseItem(id);
+            }
+            else {
+                return false;
+            }
+            journalRecords++;
+        }
+        return true;
+    }
+
+    //      
+    std::vector<const T*> pointers() const {
+        std::vector<const T*> items;
+        items.reserve(data.size());
+        data.forEach([&items](const T& item) {
+            items.push_back(&item);
+            });
+        return items;
+    }
 
 public:
     Repository(const std::string& fname) : filename(fname) {}
 
+    //    .     ,
+    //           
+    void enableJournal(size_t threshold = 1000) {
+        journaling = true;
+        compactThreshold = threshold;
+    }
+
+    // ,     .   
+    //      ,  
+    //         
+    void setStorageFormat(StorageFormat newFormat) {
+        format = newFormat;
+    }
+
+    StorageFormat storageFormat() const {
+        return format;
+    }
+
+    //     ( ,    ).
+    //     ID  
     void add(std::shared_ptr<T> item) {
-        data.push_back(item);
+        int id = item->getId();
+        insertItem(item.use_count() == 1 ? std::move(*item) : T(*item));
+        pendingOps.emplace_back('+', id);
+    }
+
+    template<typename... Args>
+    void emplace(Args&&... args) {
+        T item(std::forward<Args>(args)...);
+        int id = item.getId();
+        insertItem(std::move(item));
+        pendingOps.emplace_back('+', id);
     }
 
     bool remove(int id) {
-        auto it = std::remove_if(data.begin(), data.end(), [id](const std::shared_ptr<T>& item) {
-            return item->getId() == id;
-            });
-        if (it == data.end()) {
+        if (!eraseItem(id)) {
             return false;
         }
-        data.erase(it, data.end());
+        pendingOps.emplace_back('-', id);
         return true;
     }
 
-    std::shared_ptr<T> find(int id) const {
-        for (const auto& item : data) {
-            if (item->getId() == id) {
-                return item;
+    //  ID     O(1): ,  
+    //  ,    
+    int allocateId() {
+        while (!freeIds.empty()) {
+            int id = freeIds.back();
+            freeIds.pop_back();
+            // ID    ,     ID
+            if (!lookup(id)) {
+                return id;
+            }
+        }
+        if (nextId == std::numeric_limits<int>::max()) {
+            throw std::runtime_error("  ID");
+        }
+        return nextId++;
+    }
+
+    //  count   ID        .
+    //  ID    :     
+    int reserveIds(size_t count) {
+        if (count > static_cast<size_t>(std::numeric_limits<int>::max() - nextId)) {
+            throw std::runtime_error("  ID");
+        }
+        int first = nextId;
+        nextId += static_cast<int>(count);
+        return first;
+    }
+
+    //    ID   (  )
+    void setIdReuse(bool enabled) {
+        reuseIds = enabled;
+        if (enabled) {
+            collectFreeIds();
+        }
+        else {
+            freeIds.clear();
+        }
+    }
+
+    //  : fn(T&)   ,    
+    //  ,   add, -       .
+    // ,  find    ,  ,
+    //        .
+    //  false,     ID 
+    template<typename Fn>
+    bool update(int id, Fn fn) {
+        const T* existing = lookup(id);
+        if (!existing) {
+            return false;
+        }
+        T item(*existing);
+        fn(item);
+        if (item.getId() != id) {
+            throw std::runtime_error("    ID : " + std::to_string(id));
+        }
+        insertItem(std::move(item));
+        pendingOps.emplace_back('+', id);
+        return true;
+    }
+
+    //          
+    void attachIndex(const std::string& name, std::shared_ptr<RepositoryIndex<T>> idx) {
+        idx->onClear();
+        idx->onAttach(*this);
+        data.forEach([&idx](const T& item) {
+            idx->onStore(nullptr, item);
+            });
+        indexes.emplace_back(name, std::move(idx));
+        changes++;
+    }
+
+    //   :       
+    // .      (,  )
+    //   
+    size_t revision() const {
+        return changes;
+    }
+
+    //   : fn(, )
+    template<typename Fn>
+    void forEachIndex(Fn fn) const {
+        for (const auto& entry : indexes) {
+            fn(entry.first, *entry.second);
+        }
+    }
+
+    //       nullptr
+    template<typename Index>
+    Index* getIndex(const std::string& name) const {
+        for (const auto& entry : indexes) {
+            if (entry.first == name) {
+                return dynamic_cast<Index*>(entry.second.get());
+            }
+        }
+        return nullptr;
+    }
+
+    //    ID    ;  ID .
+    //       :  
+    // ,   ,       
+    // (remove, add  update    ID, clear  loadFromFile).   
+    // ,      ID
+    std::vector<const T*> findMany(const std::vector<int>& ids) const {
+        std::vector<const T*> results;
+        results.reserve(ids.size());
+        for (int id : ids) {
+            if (const T* item = lookup(id)) {
+                results.push_back(item);
+            }
+        }
+        return results;
+    }
+
+    //     ; count    offset
+    std::vector<const T*> ordered(const std::string& viewName, size_t offset = 0, size_t count = SIZE_MAX) const {
+        const OrderedIndex<T>* view = getIndex<OrderedIndex<T>>(viewName);
+        if (!view) {
+            throw std::runtime_error("  : " + viewName);
+        }
+        return findMany(view->page(offset, count));
+    }
+
+    //     lo  hi    RangeIndex
+    template<typename Key>
+    std::vector<const T*> range(const std::string& viewName, const Key& lo, const Key& hi) const {
+        return findMany(rangeIndex<Key>(viewName)->rangeIds(lo, hi));
+    }
+
+    template<typename Key>
+    size_t countRange(const std::string& viewName, const Key& lo, const Key& hi) const {
+        return rangeIndex<Key>(viewName)->countRange(lo, hi);
+    }
+
+    //         (. PartitionedIndex)
+    std::vector<const T*> ordered(const std::string& viewName, const std::string& group,
+        size_t offset = 0, size_t count = SIZE_MAX) const {
+        const PartitionedIndex<T>* view = getIndex<PartitionedIndex<T>>(viewName);
+        if (!view) {
+            throw std::runtime_error("  : " + viewName);
+        }
+        return findMany(view->page(group, offset, count));
+    }
+
+    // ID         .
+    //         
+    template<typename Key>
+    const std::vector<int>& idsByKey(const std::string& indexName, const Key& key) const {
+        const SecondaryIndex<T, Key>* secondary = getIndex<SecondaryIndex<T, Key>>(indexName);
+        if (!secondary) {
+            throw std::runtime_error("  : " + indexName);
+        }
+        return secondary->lookup(key);
+    }
+
+    template<typename Key>
+    std::vector<const T*> findByKey(const std::string& indexName, const Key& key) const {
+        return findMany(idsByKey(indexName, key));
+    }
+
+    // ,   (  TextIndex)  pattern
+    std::vector<const T*> searchText(const std::string& indexName, const std::string& pattern) const {
+        const TextIndex<T>* textIndex = getIndex<TextIndex<T>>(indexName);
+        if (!textIndex) {
+            throw std::runtime_error("  : " + indexName);
+        }
+        return findMany(textIndex->match(pattern));
+    }
+
+    //  k  :     - k 
+    std::vector<const T*> top(const std::string& viewName, size_t k) const {
+        return ordered(viewName, 0, k);
+    }
+
+    std::vector<const T*> top(const std::string& viewName, const std::string& group, size_t k) const {
+        return ordered(viewName, group, 0, k);
+    }
+
+    //    ID  nullptr (  , . findMany)
+    const T* find(int id) const {
+        return lookup(id);
+    }
+
+    //  :  ,    
+    Handle handleOf(int id) const {
+        size_t packed = index.find(id);
+        return packed != IdIndex::npos ? Handle::unpack(packed) : Handle();
+    }
+
+    const T* get(Handle h) const {
+        return data.get(h);
+    }
+
+    using View = RecordView<typename SlotMap<T>::const_iterator>;
+    template<typename Pred>
+    using Filtered = FilteredView<typename SlotMap<T>::const_iterator, Pred>;
+
+    //     ,      .
+    //  fn    
+    template<typename Fn>
+    void forEach(Fn fn) const {
+        data.forEach([&fn](const T& item) {
+            fn(item);
+            });
+    }
+
+    //    range-for: for (const Contract& c : repo.view())
+    View view() const {
+        return View(data.begin(), data.end());
+    }
+
+    // ,  ,  range-for;     
+    template<typename Pred>
+    Filtered<Pred> filtered(Pred pred) const {
+        return Filtered<Pred>(data.begin(), data.end(), std::move(pred));
+    }
+
+    //  ,   (  ,   find)
+    template<typename Pred>
+    const T* findFirst(Pred pred) const {
+        for (const T& item : view()) {
+            if (pred(item)) {
+                return &item;
             }
         }
         return nullptr;
     }
 
-    std::vector<std::shared_ptr<T>> findAll() const {
-        return data;
+    template<typename Pred>
+    size_t count(Pred pred) const {
+        size_t n = 0;
+        forEach([&](const T& item) {
+            if (pred(item)) n++;
+            });
+        return n;
+    }
+
+    //    -  ,    
+    // (,  );    view  forEach
+    std::vector<const T*> findAll() const {
+        return pointers();
     }
 
     size_t size() const {
         return data.size();
     }
 
-    //    -
-    std::vector<std::shared_ptr<T>> search(std::function<bool(const std::shared_ptr<T>&)> predicate) const {
-        std::vector<std::shared_ptr<T>> results;
-        for (const auto& item : data) {
+    //     : search(fieldEquals(Contract::DURATION, 30))  
+    //  const T&.  -       
+    template<typename Pred>
+    std::vector<const T*> search(Pred predicate) const {
+        std::vector<const T*> results;
+        data.forEach([&](const T& item) {
             if (predicate(item)) {
-                results.push_back(item);
+                results.push_back(&item);
             }
-        }
+            });
         return results;
     }
 
-    //    -
-    std::vector<std::shared_ptr<T>> sort(std::function<bool(const std::shared_ptr<T>&, const std::shared_ptr<T>&)> comparator) const {
-        std::vector<std::shared_ptr<T>> sortedData = data;
-        std::sort(sortedData.begin(), sortedData.end(), comparator);
-        return sortedData;
+    //   : sort(byField(Contract::AMOUNT, std::greater<>())).
+    //    ,    
+    template<typename Compare>
+    std::vector<const T*> sort(Compare comparator) const {
+        std::vector<const T*> items = pointers();
+        parallelStableSort(items, [&comparator](const T* a, const T* b) {
+            return comparator(*a, *b);
+            });
+        return items;
     }
 
-    void saveToFile() const {
-        std::ofstream file(filename, std::ios::binary | std::ios::out | std::ios::trunc);
-        if (file.is_open()) {
-            for (const auto& item : data) {
-                item->saveToFile(file);
-            }
-            file.close();
+    //    ,   - :
+    // sortBy(sortKey(Contract::STATUS), sortKey(Contract::AMOUNT, true)).
+    //      ;    ,
+    //  -  (. parallel_sort.h).     
+    template<typename... Fields>
+    std::vector<const T*> sortBy(const SortKey<Fields>&... keys) const {
+        std::vector<const T*> items = pointers();
+        sortRecords(items, keys...);
+        return items;
+    }
+
+    // -:       right  
+    //  ID- right;    ,  nullptr.
+    // visit(const T&, const R*)
+    template<typename R, typename Key, typename Visitor>
+    void join(const Repository<R>& right, Key key, Visitor visit) const {
+        data.forEach([&](const T& item) {
+            visit(item, right.find(std::invoke(key, item)));
+            });
+    }
+
+    //      (,  ->   )
+    template<typename R1, typename Key1, typename R2, typename Key2, typename Visitor>
+    void join(const Repository<R1>& right1, Key1 key1, const Repository<R2>& right2, Key2 key2, Visitor visit) const {
+        data.forEach([&](const T& item) {
+            visit(item, right1.find(std::invoke(key1, item)), right2.find(std::invoke(key2, item)));
+            });
+    }
+
+    void saveToFile() {
+        if (!journaling) {
+            writeSnapshot();
+            pendingOps.clear();
+            return;
         }
-        else {
-            throw std::runtime_error("    : " + filename);
+        appendJournal();
+        pendingOps.clear();
+        if (journalRecords >= std::max(compactThreshold, data.size())) {
+            compactJournal();
         }
     }
 
+    //     .      
+    //   ,       
+    void compactJournal() {
+        writeSnapshot();
+        if (journaling) {
+            std::ofstream log(journalFilename(), std::ios::binary | std::ios::out | std::ios::trunc);
+        }
+        journalRecords = 0;
+        journaledNextId = nextId;
+    }
+
     void loadFromFile() {
-        std::ifstream file(filename, std::ios::binary | std::ios::in);
-        if (file.is_open()) {
-            data.clear();
-            while (!file.eof()) {
-                std::shared_ptr<T> item = std::make_shared<T>();
-                item->loadFromFile(file);
-                if (file.good()) {
-                    data.push_back(item);
+        MappedFile mapped;
+        if (mapped.open(filename)) {
+            clearData();
+            try {
+                if (mapped.isBinaryStorage()) {
+                    readBinaryFile(mapped);
+                    format = StorageFormat::Binary;
+                }
+                else {
+                    readTextBuffer(mapped.data(), mapped.size());
+                    format = StorageFormat::Text;
                 }
             }
-            file.close();
+            catch (...) {
+                //         
+                clearData();
+                throw;
+            }
+        }
+        else if (std::ifstream(filename).is_open()) {
+            clearData(); //  
         }
+        journalRecords = 0;
+        //     :   
+        //           
+        if (journaling && !replayJournal()) {
+            compactJournal();
+        }
+        journaledNextId = nextId;
+        if (reuseIds) {
+            collectFreeIds();
+        }
+        pendingOps.clear();
+    }
+
+    //    :      
+    void importText(const std::string& path) {
+        MappedFile mapped;
+        bool opened = mapped.open(path);
+        if (!opened && !std::ifstream(path).is_open()) {
+            throw std::runtime_error("    : " + path);
+        }
+        clearData();
+        if (opened) {
+            readTextBuffer(mapped.data(), mapped.size());
+        }
+        pendingOps.clear();
+        compactJournal();
+    }
+
+    //         
+    void exportText(const std::string& path) const {
+        writeTextFile(path);
     }
 };
 
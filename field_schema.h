@@ -0,0 +1,315 @@
+#ifndef FIELD_SCHEMA_H
+#define FIELD_SCHEMA_H
+
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <functional>
+#include <cstddef>
+#include "record_parser.h"
+#include "record_writer.h"
+#include "binary_storage.h"
+#include "money.h"
+#include "intern_table.h"
+#include "packed_strings.h"
+
+//  :    ,     
+//  .         
+// ,    ,       
+//  .        .
+
+//   : write/parse -   (delim -   ,
+//   ), save/load - .
+//     (, Date)    
+template<typename M>
+struct FieldCodec;
+
+//   :   -  ,    -
+// ,  -  
+inline bool parseFieldText(RecordParser& parser, char delim, bool last, std::string_view& out) {
+    if (last) return parser.rest(out);
+    if (delim == ' ') return parser.token(out);
+    return parser.field(delim, out);
+}
+
+//    :      
+inline bool expectFieldDelim(RecordParser& parser, char delim, bool last) {
+    return last || delim == ' ' || parser.expect(delim);
+}
+
+template<>
+struct FieldCodec<int> {
+    static void write(RecordWriter& writer, int value, char) { writer.number(value); }
+    static bool parse(RecordParser& parser, char delim, bool last, int& value) {
+        return parser.number(value) && expectFieldDelim(parser, delim, last);
+    }
+    static void save(BinaryRecordWriter& writer, int value) { writer.putInt32(value); }
+    static void load(BinaryRecordReader& reader, int& value) { value = reader.getInt32(); }
+};
+
+template<>
+struct FieldCodec<bool> {
+    static void write(RecordWriter& writer, bool value, char) { writer.put(value ? '1' : '0'); }
+    static bool parse(RecordParser& parser, char delim, bool last, bool& value) {
+        int number = 0;
+        if (!parser.number(number) || !expectFieldDelim(parser, delim, last)) return false;
+        value = number != 0;
+        return true;
+    }
+    static void save(BinaryRecordWriter& writer, bool value) { writer.putBool(value); }
+    static void load(BinaryRecordReader& reader, bool& value) { value = reader.getBool(); }
+};
+
+template<>
+struct FieldCodec<double> {
+    static void write(RecordWriter& writer, double value, char) { writer.number(value); }
+    static bool parse(RecordParser& parser, char delim, bool last, double& value) {
+        return parser.number(value) && expectFieldDelim(parser, delim, last);
+    }
+    static void save(BinaryRecordWriter& writer, double value) { writer.putDouble(value); }
+    static void load(BinaryRecordReader& reader, double& value) { value = reader.getDouble(); }
+};
+
+template<>
+struct FieldCodec<std::string> {
+    static void write(RecordWriter& writer, const std::string& value, char) { writer.text(value); }
+    static bool parse(RecordParser& parser, char delim, bool last, std::string& value) {
+        std::string_view text;
+        if (!parseFieldText(parser, delim, last, text)) return false;
+        value.assign(text);
+        return true;
+    }
+    static void save(BinaryRecordWriter& writer, const std::string& value) { writer.putString(value); }
+    static void load(BinaryRecordReader& reader, std::string& value) { value.assign(reader.getStringView()); }
+};
+
+template<>
+struct FieldCodec<InternedString> {
+    static void write(RecordWriter& writer, const InternedString& value, char) { writer.text(value.str()); }
+    static bool parse(RecordParser& parser, char delim, bool last, InternedString& value) {
+        std::string_view text;
+        if (!parseFieldText(parser, delim, last, text)) return false;
+        value = InternedString(text);
+        return true;
+    }
+    static void save(BinaryRecordWriter& writer, const InternedString& value) { writer.putString(value.str()); }
+    static void load(BinaryRecordReader& reader, InternedString& value) { value = InternedString(reader.getStringView()); }
+};
+
+template<>
+struct FieldCodec<Money> {
+    static void write(RecordWriter& writer, Money value, char) {
+        writer.commit(value.format(writer.space(Money::MAX_FORMATTED_SIZE)));
+    }
+    static bool parse(RecordParser& parser, char delim, bool last, Money& value) {
+        std::string_view text;
+        return parseFieldText(parser, delim, last, text) && Money::parse(text, value);
+    }
+    static void save(BinaryRecordWriter& writer, Money value) { writer.putInt64(value.minorUnits()); }
+    static void load(BinaryRecordReader& reader, Money& value) {
+        if (reader.version() >= 3) {
+            value = Money::fromMinor(reader.getInt64());
+            return;
+        }
+        //   3    double
+        if (!Money::fromDouble(reader.getDouble(), value)) {
+            throw std::runtime_error("  :    ");
+        }
+    }
+};
+
+//      :      
+//  ,         
+template<size_t N>
+struct FieldCodec<PackedStrings<N>> {
+    static void write(RecordWriter& writer, const PackedStrings<N>& value, char delim) {
+        for (size_t i = 0; i < N; ++i) {
+            if (i > 0) writer.put(delim);
+            writer.text(value.get(i));
+        }
+    }
+    static bool parse(RecordParser& parser, char delim, bool last, PackedStrings<N>& value) {
+        std::string_view values[N];
+        for (size_t i = 0; i < N; ++i) {
+            if (!parseFieldText(parser, delim, last && i == N - 1, values[i])) return false;
+        }
+        value.assign(values);
+        return true;
+    }
+    static void save(BinaryRecordWriter& writer, const PackedStrings<N>& value) {
+        for (size_t i = 0; i < N; ++i) {
+            writer.putString(value.get(i));
+        }
+    }
+    static void load(BinaryRecordReader& reader, PackedStrings<N>& value) {
+        //          
+        std::string_view values[N];
+        for (auto& field : values) {
+            field = reader.getStringView();
+        }
+        value.assign(values);
+    }
+};
+
+//  : member -   C ( ID -  Entity), delim - ,
+//       .  field(item) 
+//  ,        
+template<typename C, typename M>
+struct FieldDescriptor {
+    using Owner = C;
+    using Type = M;
+
+    std::string_view name;
+    M C::* member;
+    char delim;
+
+    constexpr const M& operator()(const C& item) const { return item.*member; }
+    constexpr M& ref(C& item) const { return item.*member; }
+};
+
+template<typename C, typename M>
+constexpr FieldDescriptor<C, M> makeField(std::string_view name, M C::* member, char delim = '|') {
+    return FieldDescriptor<C, M>{ name, member, delim };
+}
+
+//  :    .   , 
+//  ,      (    )
+template<typename C, typename R>
+struct GetterField {
+    using Owner = C;
+
+    std::string_view name;
+    R (C::* getter)() const;
+
+    R operator()(const C& item) const { return (item.*getter)(); }
+};
+
+template<typename C, typename R>
+constexpr GetterField<C, R> makeField(std::string_view name, R (C::* getter)() const) {
+    return GetterField<C, R>{ name, getter };
+}
+
+//  ,      ;  -  
+template<typename Getter>
+constexpr std::string_view nameOfField(const Getter&) {
+    return std::string_view();
+}
+
+template<typename C, typename M>
+constexpr std::string_view nameOfField(const FieldDescriptor<C, M>& field) {
+    return field.name;
+}
+
+template<typename C, typename R>
+constexpr std::string_view nameOfField(const GetterField<C, R>& field) {
+    return field.name;
+}
+
+template<typename... Fields>
+class Schema {
+private:
+    std::tuple<Fields...> fields;
+
+    static constexpr size_t COUNT = sizeof...(Fields);
+
+    template<typename T, size_t... I>
+    void writeAll(const T& item, RecordWriter& writer, std::index_sequence<I...>) const {
+        ((FieldCodec<typename std::tuple_element_t<I, std::tuple<Fields...>>::Type>::write(
+            writer, std::get<I>(fields)(item), std::get<I>(fields).delim),
+            I + 1 < COUNT ? (void)writer.put(std::get<I>(fields).delim) : writer.endRecord()), ...);
+    }
+
+    template<typename T, size_t... I>
+    bool parseAll(T& item, RecordParser& parser, std::index_sequence<I...>) const {
+        return (FieldCodec<typename std::tuple_element_t<I, std::tuple<Fields...>>::Type>::parse(
+            parser, std::get<I>(fields).delim, I + 1 == COUNT, std::get<I>(fields).ref(item)) && ...);
+    }
+
+public:
+    constexpr explicit Schema(Fields... fields) : fields(fields...) {}
+
+    static constexpr size_t size() { return COUNT; }
+
+    //     
+    template<typename T>
+    void write(const T& item, RecordWriter& writer) const {
+        writeAll(item, writer, std::index_sequence_for<Fields...>());
+    }
+
+    //   ; false,   
+    template<typename T>
+    bool parse(T& item, RecordParser& parser) const {
+        return parseAll(item, parser, std::index_sequence_for<Fields...>());
+    }
+
+    template<typename T>
+    void save(const T& item, BinaryRecordWriter& writer) const {
+        std::apply([&](const auto&... field) {
+            (FieldCodec<typename std::decay_t<decltype(field)>::Type>::save(writer, field(item)), ...);
+            }, fields);
+    }
+
+    template<typename T>
+    void load(T& item, BinaryRecordReader& reader) const {
+        std::apply([&](const auto&... field) {
+            (FieldCodec<typename std::decay_t<decltype(field)>::Type>::load(reader, field.ref(item)), ...);
+            }, fields);
+    }
+};
+
+template<typename... Fields>
+constexpr Schema<Fields...> makeSchema(Fields... fields) {
+    return Schema<Fields...>(fields...);
+}
+
+//    : repo.sort(byField(Contract::AMOUNT, std::greater<>()))
+template<typename F, typename Compare = std::less<>>
+struct FieldOrder {
+    F field;
+    Compare compare;
+
+    template<typename T>
+    bool operator()(const T& a, const T& b) const { return compare(field(a), field(b)); }
+};
+
+template<typename F, typename Compare = std::less<>>
+constexpr FieldOrder<F, Compare> byField(F field, Compare compare = Compare()) {
+    return FieldOrder<F, Compare>{ field, compare };
+}
+
+//   : repo.search(fieldEquals(Contract::DURATION, 30))
+template<typename F, typename V>
+struct FieldEquals {
+    F field;
+    V value;
+
+    template<typename T>
+    bool operator()(const T& item) const { return field(item) == value; }
+};
+
+template<typename F, typename V>
+constexpr FieldEquals<F, V> fieldEquals(F field, V value) {
+    return FieldEquals<F, V>{ field, value };
+}
+
+// lo <=  <= hi
+template<typename F, typename V>
+struct FieldBetween {
+    F field;
+    V lo;
+    V hi;
+
+    template<typename T>
+    bool operator()(const T& item) const {
+        const auto& value = field(item);
+        return !(value < lo) && !(hi < value);
+    }
+};
+
+template<typename F, typename V>
+constexpr FieldBetween<F, V> fieldBetween(F field, V lo, V hi) {
+    return FieldBetween<F, V>{ field, lo, hi };
+}
+
+#endif // FIELD_SCHEMA_H
\ No newline at end of file
@@ -0,0 +1,133 @@
+#ifndef ID_INDEX_H
+#define ID_INDEX_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <climits>
+#include <stdexcept>
+#include <string>
+
+// - "ID ->  "    ( ).
+// ,      O(1)  .
+//  INT_MIN   ,   ID    .
+class IdIndex {
+private:
+    static constexpr int EMPTY = INT_MIN;
+
+    struct Bucket {
+        int id;
+        size_t slot;
+    };
+
+    std::vector<Bucket> buckets;
+    size_t count;
+    unsigned shift;
+
+    size_t bucketOf(int id) const {
+        //  :    ID
+        return static_cast<size_t>((static_cast<uint64_t>(static_cast<uint32_t>(id)) * 0x9E3779B97F4A7C15ull) >> shift);
+    }
+
+    void rehash(size_t newCapacity) {
+        std::vector<Bucket> old;
+        old.swap(buckets);
+        buckets.assign(newCapacity, Bucket{ EMPTY, 0 });
+        shift = 64;
+        for (size_t c = newCapacity; c > 1; c >>= 1) {
+            shift--;
+        }
+        count = 0;
+        for (const auto& b : old) {
+            if (b.id != EMPTY) {
+                insert(b.id, b.slot);
+            }
+        }
+    }
+
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    IdIndex() : count(0), shift(64) {
+        rehash(16);
+    }
+
+    // ID,     
+    static constexpr bool accepts(int id) {
+        return id != EMPTY;
+    }
+
+    size_t size() const {
+        return count;
+    }
+
+    void clear() {
+        buckets.assign(buckets.size(), Bucket{ EMPTY, 0 });
+        count = 0;
+    }
+
+    void reserve(size_t n) {
+        size_t capacity = buckets.size();
+        while (n * 10 > capacity * 7) {
+            capacity *= 2;
+        }
+        if (capacity != buckets.size()) {
+            rehash(capacity);
+        }
+    }
+
+    //     npos,  ID  
+    size_t find(int id) const {
+        if (!accepts(id)) return npos;
+        size_t mask = buckets.size() - 1;
+        for (size_t i = bucketOf(id);; i = (i + 1) & mask) {
+            if (buckets[i].id == id) return buckets[i].slot;
+            if (buckets[i].id == EMPTY) return npos;
+        }
+    }
+
+    //  ID     
+    void insert(int id, size_t slot) {
+        if (!accepts(id)) {
+            throw std::runtime_error(" ID : " + std::to_string(id));
+        }
+        reserve(count + 1);
+        size_t mask = buckets.size() - 1;
+        for (size_t i = bucketOf(id);; i = (i + 1) & mask) {
+            if (buckets[i].id == id) {
+                buckets[i].slot = slot;
+                return;
+            }
+            if (buckets[i].id == EMPTY) {
+                buckets[i] = Bucket{ id, slot };
+                count++;
+                return;
+            }
+        }
+    }
+
+    //      ( "")
+    bool erase(int id) {
+        if (!accepts(id)) return false;
+        size_t mask = buckets.size() - 1;
+        size_t i = bucketOf(id);
+        while (buckets[i].id != id) {
+            if (buckets[i].id == EMPTY) return false;
+            i = (i + 1) & mask;
+        }
+        size_t hole = i;
+        for (size_t j = (hole + 1) & mask; buckets[j].id != EMPTY; j = (j + 1) & mask) {
+            size_t home = bucketOf(buckets[j].id);
+            //     "",          
+            if (((j - home) & mask) >= ((j - hole) & mask)) {
+                buckets[hole] = buckets[j];
+                hole = j;
+            }
+        }
+        buckets[hole] = Bucket{ EMPTY, 0 };
+        count--;
+        return true;
+    }
+};
+
+#endif // ID_INDEX_H
\ No newline at end of file
@@ -8,6 +8,7 @@
 #include <regex>
 #include <climits>
 #include <vector>
+#include "contracts.h"
 
 using namespace std;
 
@@ -61,19 +62,8 @@ bool isValidDateString(const string& date) {
         return false;
     }
 
-    regex datePattern(R"(^(0[1-9]|[12][0-9]|3[01])\.(0[1-9]|1[0-2])\.\d{4}$)");
-    if (!regex_match(date, datePattern)) return false;
-
-    size_t dot1 = date.find('.');
-    size_t dot2 = date.find('.', dot1 + 1);
-    int day = stoi(date.substr(0, dot1));
-    int month = stoi(date.substr(dot1 + 1, dot2 - dot1 - 1));
-    int year = stoi(date.substr(dot2 + 1));
-
-    bool isLeap = (year % 4 == 0 && year % 100 != 0) || (year % 400 == 0);
-    if (month == 2) return (isLeap) ? day <= 29 : day <= 28;
-    if (month == 4 || month == 6 || month == 9 || month == 11) return day <= 30;
-    return true;
+    Date parsed;
+    return Date::parse(date, parsed);
 }
 
 //     
@@ -152,6 +142,32 @@ double safeInputDouble(const string& prompt, double minVal = 0.0, double maxVal
     }
 }
 
+//    : "1500", "1500.50"  "1500,50",   
+Money safeInputMoney(const string& prompt, Money minVal = Money(), Money maxVal = Money::fromUnits(1000000000)) {
+    string input;
+    Money value;
+
+    while (true) {
+        cout << prompt;
+        getline(cin, input);
+
+        if (input.empty()) {
+            cout << "!     . ,  : ";
+            continue;
+        }
+        if (!Money::parse(input, value)) {
+            cout << "!   ,  -    : ";
+            continue;
+        }
+        if (value < minVal || value > maxVal) {
+            cout << "!       " << minVal << "  " << maxVal << "." << endl;
+            cout << ",   : ";
+            continue;
+        }
+        return value;
+    }
+}
+
 //    ( )
 string safeInputString(const string& prompt) {
     string value;
@@ -247,6 +263,13 @@ string safeInputDateString(const string& prompt) {
     }
 }
 
+//      DD.MM.YYYY    Date
+Date safeInputDate(const string& prompt) {
+    Date date;
+    Date::parse(safeInputDateString(prompt), date);
+    return date;
+}
+
 //   
 string safeInputLogin(const string& prompt) {
     string login;
@@ -0,0 +1,45 @@
+#include "intern_table.h"
+#include <mutex>
+
+using namespace std;
+
+InternTable::InternTable() {
+    entries.push_back(Entry{ string(), 0 });
+    byText.emplace(string_view(entries.front().text), &entries.front());
+}
+
+InternTable& InternTable::instance() {
+    static InternTable table;
+    return table;
+}
+
+const InternTable::Entry* InternTable::intern(string_view text) {
+    {
+        shared_lock<shared_mutex> lock(mutex);
+        auto it = byText.find(text);
+        if (it != byText.end()) {
+            return it->second;
+        }
+    }
+    unique_lock<shared_mutex> lock(mutex);
+    //   ,    
+    auto it = byText.find(text);
+    if (it != byText.end()) {
+        return it->second;
+    }
+    entries.push_back(Entry{ string(text), static_cast<uint32_t>(entries.size()) });
+    const Entry* entry = &entries.back();
+    byText.emplace(string_view(entry->text), entry);
+    return entry;
+}
+
+const InternTable::Entry* InternTable::find(string_view text) const {
+    shared_lock<shared_mutex> lock(mutex);
+    auto it = byText.find(text);
+    return it != byText.end() ? it->second : nullptr;
+}
+
+size_t InternTable::size() const {
+    shared_lock<shared_mutex> lock(mutex);
+    return entries.size();
+}
\ No newline at end of file
@@ -0,0 +1,74 @@
+#ifndef INTERN_TABLE_H
+#define INTERN_TABLE_H
+
+#include <string>
+#include <string_view>
+#include <deque>
+#include <unordered_map>
+#include <shared_mutex>
+#include <cstdint>
+#include <iostream>
+
+//          
+// ( , ,  ).     
+//    ;       .
+//     ,     
+// (, , )    .
+//      ,    :
+//         .
+class InternTable {
+public:
+    struct Entry {
+        std::string text;
+        uint32_t code;
+    };
+
+private:
+    std::deque<Entry> entries; //      
+    std::unordered_map<std::string_view, const Entry*> byText;
+    mutable std::shared_mutex mutex;
+
+    InternTable();
+
+public:
+    InternTable(const InternTable&) = delete;
+    InternTable& operator=(const InternTable&) = delete;
+
+    static InternTable& instance();
+
+    //   ;     
+    const Entry* intern(std::string_view text);
+    //     nullptr,      
+    const Entry* find(std::string_view text) const;
+    //  ,  0
+    const Entry* empty() const { return &entries.front(); }
+    size_t size() const;
+};
+
+//    : 8   std::string,
+//    -  
+class InternedString {
+private:
+    const InternTable::Entry* entry;
+
+public:
+    InternedString() : entry(InternTable::instance().empty()) {}
+    InternedString(std::string_view text) : entry(InternTable::instance().intern(text)) {}
+    InternedString(const std::string& text) : InternedString(std::string_view(text)) {}
+    InternedString(const char* text) : InternedString(std::string_view(text)) {}
+
+    const std::string& str() const { return entry->text; }
+    //    ,    (,  )
+    operator const std::string&() const { return entry->text; }
+    uint32_t code() const { return entry->code; }
+    bool empty() const { return entry->text.empty(); }
+
+    bool operator==(const InternedString& other) const { return entry == other.entry; }
+    bool operator!=(const InternedString& other) const { return entry != other.entry; }
+};
+
+inline std::ostream& operator<<(std::ostream& os, const InternedString& value) {
+    return os << value.str();
+}
+
+#endif // INTERN_TABLE_H
\ No newline at end of file
@@ -0,0 +1,243 @@
+#include "interval_index.h"
+#include <algorithm>
+#include <tuple>
+
+using namespace std;
+
+uint32_t ContractIntervalIndex::nextPriority() {
+    // xorshift32:      ,  
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+}
+
+bool ContractIntervalIndex::before(int a, int start, int id) const {
+    return nodes[a].start < start || (nodes[a].start == start && nodes[a].id < id);
+}
+
+void ContractIntervalIndex::update(int t) {
+    Node& n = nodes[t];
+    n.maxEnd = n.end;
+    n.count = 1;
+    if (n.left != NIL) {
+        n.maxEnd = max(n.maxEnd, nodes[n.left].maxEnd);
+        n.count += nodes[n.left].count;
+    }
+    if (n.right != NIL) {
+        n.maxEnd = max(n.maxEnd, nodes[n.right].maxEnd);
+        n.count += nodes[n.right].count;
+    }
+}
+
+void ContractIntervalIndex::split(int t, int start, int id, int& left, int& right) {
+    if (t == NIL) {
+        left = right = NIL;
+        return;
+    }
+    if (before(t, start, id)) {
+        split(nodes[t].right, start, id, nodes[t].right, right);
+        left = t;
+    }
+    else {
+        split(nodes[t].left, start, id, left, nodes[t].left);
+        right = t;
+    }
+    update(t);
+}
+
+int ContractIntervalIndex::merge(int left, int right) {
+    if (left == NIL) return right;
+    if (right == NIL) return left;
+    if (nodes[left].priority > nodes[right].priority) {
+        nodes[left].right = merge(nodes[left].right, right);
+        update(left);
+        return left;
+    }
+    nodes[right].left = merge(left, nodes[right].left);
+    update(right);
+    return right;
+}
+
+int ContractIntervalIndex::detach(int t, int start, int id, int& removed) {
+    if (t == NIL) {
+        return NIL;
+    }
+    if (nodes[t].start == start && nodes[t].id == id) {
+        removed = t;
+        return merge(nodes[t].left, nodes[t].right);
+    }
+    if (before(t, start, id)) {
+        nodes[t].right = detach(nodes[t].right, start, id, removed);
+    }
+    else {
+        nodes[t].left = detach(nodes[t].left, start, id, removed);
+    }
+    update(t);
+    return t;
+}
+
+void ContractIntervalIndex::collectOverlaps(int t, int from, int to, vector<int>& out) const {
+    //      
+    if (t == NIL || nodes[t].maxEnd <= from) {
+        return;
+    }
+    const Node& n = nodes[t];
+    collectOverlaps(n.left, from, to, out);
+    //      :     ,  
+    if (n.start >= to) {
+        return;
+    }
+    if (n.end > from) {
+        out.push_back(n.id);
+    }
+    collectOverlaps(n.right, from, to, out);
+}
+
+size_t ContractIntervalIndex::countStartingBefore(int day) const {
+    size_t count = 0;
+    int t = root;
+    while (t != NIL) {
+        const Node& n = nodes[t];
+        if (n.start < day) {
+            count += 1 + (n.left != NIL ? nodes[n.left].count : 0);
+            t = n.right;
+        }
+        else {
+            t = n.left;
+        }
+    }
+    return count;
+}
+
+void ContractIntervalIndex::insertInterval(int id, int start, int end) {
+    int t;
+    if (!freeNodes.empty()) {
+        t = freeNodes.back();
+        freeNodes.pop_back();
+    }
+    else {
+        t = static_cast<int>(nodes.size());
+        nodes.emplace_back();
+    }
+    nodes[t] = Node{ start, end, id, end, 1, nextPriority(), NIL, NIL };
+    byEnd.insert(end - 1, id);
+
+    int left, right;
+    split(root, start, id, left, right);
+    root = merge(merge(left, t), right);
+}
+
+void ContractIntervalIndex::eraseInterval(int id, int start, int end) {
+    int removed = NIL;
+    root = detach(root, start, id, removed);
+    if (removed != NIL) {
+        byEnd.erase(end - 1, id);
+        freeNodes.push_back(removed);
+    }
+}
+
+void ContractIntervalIndex::period(const Contract& contract, int& start, int& end) {
+    start = contract.getStartDate().toDayNumber();
+    end = start + contract.getDuration();
+}
+
+void ContractIntervalIndex::onAttach(const Repository<Contract>& source) {
+    repo = &source;
+}
+
+void ContractIntervalIndex::onStore(const Contract* previous, const Contract& contract) {
+    int start, end;
+    period(contract, start, end);
+    if (previous) {
+        int oldStart, oldEnd;
+        period(*previous, oldStart, oldEnd);
+        if (oldStart == start && oldEnd == end) {
+            return;
+        }
+        eraseInterval(contract.getId(), oldStart, oldEnd);
+    }
+    //     (,      )
+    //      .      :  
+    //    byEnd,     ,  countOverlapping    
+    if (end > start) {
+        insertInterval(contract.getId(), start, end);
+    }
+}
+
+void ContractIntervalIndex::onErase(const Contract& contract) {
+    int start, end;
+    period(contract, start, end);
+    eraseInterval(contract.getId(), start, end);
+}
+
+void ContractIntervalIndex::onClear() {
+    nodes.clear();
+    freeNodes.clear();
+    root = NIL;
+    byEnd.clear();
+}
+
+vector<int> ContractIntervalIndex::activeOn(int day) const {
+    return overlapping(day, day + 1);
+}
+
+vector<int> ContractIntervalIndex::overlapping(int from, int to) const {
+    vector<int> result;
+    if (from < to) {
+        collectOverlaps(root, from, to, result);
+    }
+    return result;
+}
+
+size_t ContractIntervalIndex::countOverlapping(int from, int to) const {
+    if (from >= to) {
+        return 0;
+    }
+    //    ,     
+    // (   ,     )
+    return countStartingBefore(to) - byEnd.rankBefore(from);
+}
+
+vector<int> ContractIntervalIndex::endingBetween(int from, int to) const {
+    vector<int> result;
+    size_t first = byEnd.rankBefore(from);
+    size_t last = byEnd.rankNotAfter(to);
+    if (last > first) {
+        result.reserve(last - first);
+        byEnd.forEach(first, last - first, [&result](const OrderedKeyList<int>::Entry& entry) {
+            result.push_back(entry.id);
+            return true;
+            });
+    }
+    return result;
+}
+
+vector<pair<int, int>> ContractIntervalIndex::overlappingPairs(const vector<int>& ids) const {
+    vector<tuple<int, int, int>> intervals; // , , ID
+    intervals.reserve(ids.size());
+    for (int id : ids) {
+        if (const Contract* contract = repo ? repo->find(id) : nullptr) {
+            int start, end;
+            period(*contract, start, end);
+            if (end > start) {
+                intervals.emplace_back(start, end, id);
+            }
+        }
+    }
+    sort(intervals.begin(), intervals.end());
+
+    //   :  ,      
+    vector<pair<int, int>> result;
+    vector<tuple<int, int, int>> active;
+    for (const auto& current : intervals) {
+        active.erase(remove_if(active.begin(), active.end(), [&current](const tuple<int, int, int>& a) {
+            return get<1>(a) <= get<0>(current);
+            }), active.end());
+        for (const auto& a : active) {
+            result.emplace_back(get<2>(a), get<2>(current));
+        }
+        active.push_back(current);
+    }
+    return result;
+}
\ No newline at end of file
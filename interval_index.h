@@ -0,0 +1,74 @@
+#ifndef INTERVAL_INDEX_H
+#define INTERVAL_INDEX_H
+
+#include "contracts.h"
+#include "sorted_view.h"
+#include <vector>
+#include <utility>
+#include <cstdint>
+
+//     [,  + )    01.01.1970.
+//      (treap)  ,   
+//     ,  ,  
+//   ,   .
+//       "  ".
+class ContractIntervalIndex : public PeriodIndex<Contract> {
+private:
+    static constexpr int NIL = -1;
+
+    struct Node {
+        int start;
+        int end;
+        int id;
+        int maxEnd;
+        int count; //    
+        uint32_t priority;
+        int left;
+        int right;
+    };
+
+    std::vector<Node> nodes;
+    std::vector<int> freeNodes;
+    int root = NIL;
+    OrderedKeyList<int> byEnd;
+    const Repository<Contract>* repo = nullptr;
+    uint32_t seed = 2463534242u;
+
+    uint32_t nextPriority();
+    bool before(int a, int start, int id) const; //   a  (start, id)
+    void update(int t);
+    void split(int t, int start, int id, int& left, int& right); // left < (start, id) <= right
+    int merge(int left, int right);
+    int detach(int t, int start, int id, int& removed); //  t   (start, id)
+    void collectOverlaps(int t, int from, int to, std::vector<int>& out) const;
+    size_t countStartingBefore(int day) const;
+    void insertInterval(int id, int start, int end);
+    void eraseInterval(int id, int start, int end);
+    static void period(const Contract& contract, int& start, int& end);
+
+public:
+    // ,       
+    static constexpr const char* INDEX_NAME = "intervals";
+
+    void onAttach(const Repository<Contract>& source) override;
+    void onStore(const Contract* previous, const Contract& contract) override;
+    void onErase(const Contract& contract) override;
+    void onClear() override;
+    std::string_view fieldName() const override { return Contract::START_DATE.name; }
+
+    //     (      )
+    size_t size() const { return root != NIL ? static_cast<size_t>(nodes[root].count) : 0; }
+
+    // ,    day,    
+    std::vector<int> activeOn(int day) const;
+    // ,      [from, to),    
+    std::vector<int> overlapping(int from, int to) const override;
+    //    O(log N),  
+    size_t countOverlapping(int from, int to) const override;
+    // ,       [from, to],    
+    std::vector<int> endingBetween(int from, int to) const;
+    //        (,  )
+    std::vector<std::pair<int, int>> overlappingPairs(const std::vector<int>& ids) const;
+};
+
+#endif // INTERVAL_INDEX_H
\ No newline at end of file
@@ -4,7 +4,16 @@
 #include <limits> 
 #include <string>
 #include <iomanip>
+#include <future>
+#include <ctime>
 #include "contracts.h"
+#include "contract_table.h"
+#include "sorted_view.h"
+#include "trigram_index.h"
+#include "secondary_index.h"
+#include "bitmap_index.h"
+#include "interval_index.h"
+#include "query.h"
 #include "input_validation.h"
 
 using namespace std;
@@ -14,12 +23,42 @@ Repository<User> userRepo("users.dat");
 Repository<Client> clientRepo("clients.dat");
 Repository<ConstructionObject> objectRepo("objects.dat");
 Repository<Contract> contractRepo("contracts.dat");
+shared_ptr<ContractTable> contractTable = make_shared<ContractTable>();
+shared_ptr<ContractIntervalIndex> contractIntervals = make_shared<ContractIntervalIndex>();
+
+//   ,  
+const string CONTRACTS_BY_START = "contractsByStart";
+const string CONTRACTS_BY_AMOUNT = "contractsByAmount";
+const string CONTRACTS_BY_AMOUNT_DESC = "contractsByAmountDesc";
+const string CONTRACTS_BY_DURATION_DESC = "contractsByDurationDesc";
+const string CLIENTS_BY_COMPANY = "clientsByCompany";
+const string OBJECTS_BY_AREA = "objectsByArea";
+const string OBJECTS_BY_AREA_DESC = "objectsByAreaDesc";
+const string CONTRACTS_BY_STATUS_AMOUNT_DESC = "contractsByStatusAmountDesc";
+const string CONTRACTS_BY_STATUS_DURATION_DESC = "contractsByStatusDurationDesc";
+const string CONTRACTS_BY_MANAGER_AMOUNT_DESC = "contractsByManagerAmountDesc";
+const string CONTRACTS_BY_MANAGER_DURATION_DESC = "contractsByManagerDurationDesc";
+
+//      
+const string CLIENTS_COMPANY_TEXT = "clientsCompanyText";
+const string OBJECTS_TYPE_TEXT = "objectsTypeText";
+const string CONTRACTS_MANAGER_TEXT = "contractsManagerText";
+
+//    
+const string CONTRACTS_BY_CLIENT = "contractsByClient";
+const string CONTRACTS_BY_OBJECT = "contractsByObject";
+const string CONTRACTS_BY_MANAGER = "contractsByManager";
+
+//         
+const string CONTRACTS_STATUS_BITMAP = "contractsStatusBitmap";
+const string CONTRACTS_WORK_TYPE_BITMAP = "contractsWorkTypeBitmap";
+const string OBJECTS_TYPE_BITMAP = "objectsTypeBitmap";
 
 void initData();
 void menu();
 void signIn();
-void userMenu(shared_ptr<User> user);
-void adminMenu(shared_ptr<User> user);
+void userMenu(const User& user);
+void adminMenu(const User& user);
 void handleDataMenu();
 void printDataMenu();
 void addDataMenu();
@@ -30,41 +69,246 @@ void editObject();
 void editContract();
 void searchDataMenu();
 void sortDataMenu();
+void exportDataMenu();
+void importDataMenu();
+void storageFormatMenu();
 void generateReport();
 void handleAccountsMenu();
 void showMostProfitableContract();
+void rankingMenu();
+void filterContracts();
+void queryContracts();
+void scheduleMenu();
 
-//      ID
-template<typename T>
-int getNextId(const Repository<T>& repo) {
-    int maxId = 0;
-    auto allItems = repo.findAll();
-    for (const auto& item : allItems) {
-        if (item->getId() > maxId) {
-            maxId = item->getId();
-        }
+//      
+//        
+void showMostProfitableContract() {
+    const Contract* mostProfitable = contractRepo.find(contractTable->maxAmountId());
+    if (!mostProfitable) {
+        cout << "   ." << endl;
+        return;
     }
-    return maxId + 1;
+
+    cout << "\n======    ======" << endl;
+    mostProfitable->display();
+    cout << "=======================================" << endl;
 }
 
-//      
-void showMostProfitableContract() {
-    auto contracts = contractRepo.findAll();
-    if (contracts.empty()) {
+//  K     ,        
+void showTopContracts(bool byAmount) {
+    size_t k = static_cast<size_t>(safeInputInt("  : ", 1, 1000));
+    cout << ": 0 - , 1 -  , 2 -  " << endl;
+    int filter = safeInputInt(" : ", 0, 2);
+
+    vector<const Contract*> results;
+    if (filter == 1) {
+        string status = selectStatusForSearch();
+        results = contractRepo.top(byAmount ? CONTRACTS_BY_STATUS_AMOUNT_DESC : CONTRACTS_BY_STATUS_DURATION_DESC, status, k);
+    }
+    else if (filter == 2) {
+        string manager = safeInputAlphaString(": ");
+        results = contractRepo.top(byAmount ? CONTRACTS_BY_MANAGER_AMOUNT_DESC : CONTRACTS_BY_MANAGER_DURATION_DESC, manager, k);
+    }
+    else {
+        results = contractRepo.top(byAmount ? CONTRACTS_BY_AMOUNT_DESC : CONTRACTS_BY_DURATION_DESC, k);
+    }
+
+    if (results.empty()) {
         cout << "   ." << endl;
         return;
     }
+    cout << "\n  " << (byAmount ? " " : " ") << " (" << results.size() << "):\n";
+    for (const auto& contract : results) {
+        contract->display();
+    }
+}
+
+void showLargestObjects() {
+    size_t k = static_cast<size_t>(safeInputInt("  : ", 1, 1000));
+    auto results = objectRepo.top(OBJECTS_BY_AREA_DESC, k);
+    if (results.empty()) {
+        cout << "   ." << endl;
+        return;
+    }
+    cout << "\n    (" << results.size() << "):\n";
+    for (const auto& object : results) {
+        object->display();
+    }
+}
+
+//      [minAmount, maxAmount]   
+void showContractsByAmount(Money minAmount, Money maxAmount) {
+    size_t found = contractRepo.countRange(CONTRACTS_BY_AMOUNT, minAmount, maxAmount);
+    cout << "\n   ";
+    if (minAmount > Money::min()) cout << "  " << minAmount;
+    if (maxAmount < Money::max()) cout << "  " << maxAmount;
+    cout << ": " << found << endl;
+    for (const auto& contract : contractRepo.range(CONTRACTS_BY_AMOUNT, minAmount, maxAmount)) {
+        contract->display();
+    }
+}
+
+//  :       ,
+//   
+void filterContracts() {
+    auto statuses = contractRepo.getIndex<ValueBitmapIndex<Contract>>(CONTRACTS_STATUS_BITMAP);
+    auto workTypes = contractRepo.getIndex<ValueBitmapIndex<Contract>>(CONTRACTS_WORK_TYPE_BITMAP);
+    auto objectTypes = objectRepo.getIndex<ValueBitmapIndex<ConstructionObject>>(OBJECTS_TYPE_BITMAP);
+
+    RoaringBitmap result = statuses->all();
+    if (safeInputInt("  ? (1 - , 0 - ): ", 0, 1)) {
+        result = result & statuses->bitmap(selectStatusForSearch());
+    }
+    if (safeInputInt("   ? (1 - , 0 - ): ", 0, 1)) {
+        result = result & workTypes->bitmap(selectWorkType());
+    }
+    if (safeInputInt("   ? (1 - , 0 - ): ", 0, 1)) {
+        //        
+        RoaringBitmap byObjectType;
+        objectTypes->bitmap(selectObjectType()).forEach([&byObjectType](uint32_t objectId) {
+            for (int contractId : contractRepo.idsByKey(CONTRACTS_BY_OBJECT, static_cast<int>(objectId))) {
+                byObjectType.add(static_cast<uint32_t>(contractId));
+            }
+            });
+        result = result & byObjectType;
+    }
+    if (safeInputInt(" ? (1 - , 0 - ): ", 0, 1)) {
+        result = result.andNot(statuses->bitmap(selectStatusForSearch()));
+    }
 
-    shared_ptr<Contract> mostProfitable = contracts[0];
+    auto contracts = contractRepo.findMany(result.toVector());
+    cout << "\n : " << contracts.size() << endl;
     for (const auto& contract : contracts) {
-        if (contract->getAmount() > mostProfitable->getAmount()) {
-            mostProfitable = contract;
+        contract->display();
+    }
+}
+
+//  :    ,    
+void queryContracts() {
+    Query<Contract> query(contractRepo);
+    if (safeInputInt("  ? (1 - , 0 - ): ", 0, 1)) {
+        query.where(eq(Contract::STATUS, selectStatusForSearch()));
+    }
+    if (safeInputInt("  ? (1 - , 0 - ): ", 0, 1)) {
+        query.where(contains(Contract::MANAGER, safeInputAlphaString("  : ")));
+    }
+    if (safeInputInt("  ? (1 - , 0 - ): ", 0, 1)) {
+        query.where(eq(Contract::CLIENT_ID, safeInputInt("ID : ", 1, 10000)));
+    }
+    if (safeInputInt("  ? (1 - , 0 - ): ", 0, 1)) {
+        Money minAmount = safeInputMoney(" : ");
+        Money maxAmount = safeInputMoney(" : ", minAmount);
+        query.where(between(Contract::AMOUNT, minAmount, maxAmount));
+    }
+    if (safeInputInt("   ? (1 - , 0 - ): ", 0, 1)) {
+        Date from = safeInputDate("  (  ..): ");
+        Date to = safeInputDate("   (  ..): ");
+        query.where(overlaps(Contract::START_DATE, Contract::DURATION, from, to));
+    }
+
+    cout << ": 0 - , 1 -  , 2 -   " << endl;
+    int order = safeInputInt(" : ", 0, 2);
+    if (order != 0) {
+        bool descending = safeInputInt(" ? (1 - , 0 - ): ", 0, 1) == 1;
+        if (order == 1) {
+            query.orderBy(Contract::AMOUNT, descending);
+        }
+        else {
+            query.orderBy(Contract::START_DATE, descending);
         }
     }
+    query.offset(static_cast<size_t>(safeInputInt(" : ", 0, 1000000)));
+    query.limit(static_cast<size_t>(safeInputInt("  : ", 1, 1000)));
 
-    cout << "\n======    ======" << endl;
-    mostProfitable->display();
-    cout << "=======================================" << endl;
+    cout << "\n" << query.explain();
+    auto contracts = query.run();
+    cout << "\n : " << contracts.size() << endl;
+    for (const auto& contract : contracts) {
+        contract->display();
+    }
+}
+
+Date currentDate() {
+    time_t now = time(nullptr);
+    tm local{};
+#ifdef _WIN32
+    localtime_s(&local, &now);
+#else
+    localtime_r(&now, &local);
+#endif
+    return Date(local.tm_mday, local.tm_mon + 1, local.tm_year + 1900);
+}
+
+void printContracts(const vector<int>& ids) {
+    auto contracts = contractRepo.findMany(ids);
+    cout << "\n : " << contracts.size() << endl;
+    for (const auto& contract : contracts) {
+        contract->display();
+    }
+}
+
+//      [ ,   + )
+void scheduleMenu() {
+    int choice;
+    do {
+        cout << "\n__________  __________" << endl;
+        cout << "1. ,   " << endl;
+        cout << "2. ,   " << endl;
+        cout << "3. ,    30 " << endl;
+        cout << "4.     " << endl;
+        cout << "0. " << endl;
+
+        choice = safeInputInt(" : ", 0, 4);
+
+        switch (choice) {
+        case 1: {
+            Date date = safeInputDate(" (  ..): ");
+            printContracts(contractIntervals->activeOn(date.toDayNumber()));
+            break;
+        }
+        case 2: {
+            Date from = safeInputDate("  (  ..): ");
+            Date to = safeInputDate("   (  ..): ");
+            printContracts(contractIntervals->overlapping(from.toDayNumber(), to.toDayNumber() + 1));
+            break;
+        }
+        case 3: {
+            int today = currentDate().toDayNumber();
+            printContracts(contractIntervals->endingBetween(today, today + 30));
+            break;
+        }
+        case 4: {
+            string managerName = safeInputAlphaString("  : ");
+            auto pairs = contractIntervals->overlappingPairs(contractRepo.idsByKey(CONTRACTS_BY_MANAGER, managerName));
+            cout << "\n : " << pairs.size() << endl;
+            for (const auto& p : pairs) {
+                cout << " " << p.first << "  " << p.second << "   " << endl;
+            }
+            break;
+        }
+        case 0: return;
+        }
+    } while (choice != 0);
+}
+
+void rankingMenu() {
+    int choice;
+    do {
+        cout << "\n____________________" << endl;
+        cout << "1.    " << endl;
+        cout << "2.    " << endl;
+        cout << "3.    " << endl;
+        cout << "0. " << endl;
+
+        choice = safeInputInt(" : ", 0, 3);
+
+        switch (choice) {
+        case 1: showTopContracts(true); break;
+        case 2: showTopContracts(false); break;
+        case 3: showLargestObjects(); break;
+        case 0: return;
+        }
+    } while (choice != 0);
 }
 
 int main() {
@@ -84,10 +328,47 @@ int main() {
 }
 
 void initData() {
-    userRepo.loadFromFile();
-    clientRepo.loadFromFile();
-    objectRepo.loadFromFile();
-    contractRepo.loadFromFile();
+    userRepo.enableJournal();
+    clientRepo.enableJournal();
+    objectRepo.enableJournal();
+    contractRepo.enableJournal();
+
+    contractRepo.attachIndex(ContractTable::INDEX_NAME, contractTable);
+    contractRepo.attachIndex(ContractIntervalIndex::INDEX_NAME, contractIntervals);
+    contractRepo.attachIndex(CONTRACTS_BY_START, makeSortedView<Contract>(Contract::START_DATE));
+    contractRepo.attachIndex(CONTRACTS_BY_AMOUNT, makeSortedView<Contract>(Contract::AMOUNT));
+    contractRepo.attachIndex(CONTRACTS_BY_AMOUNT_DESC, makeSortedView<Contract>(Contract::AMOUNT, greater<>()));
+    contractRepo.attachIndex(CONTRACTS_BY_DURATION_DESC, makeSortedView<Contract>(Contract::DURATION, greater<>()));
+    clientRepo.attachIndex(CLIENTS_BY_COMPANY, makeSortedView<Client>(Client::COMPANY_NAME));
+    objectRepo.attachIndex(OBJECTS_BY_AREA, makeSortedView<ConstructionObject>(ConstructionObject::AREA));
+    objectRepo.attachIndex(OBJECTS_BY_AREA_DESC, makeSortedView<ConstructionObject>(ConstructionObject::AREA, greater<>()));
+    contractRepo.attachIndex(CONTRACTS_BY_STATUS_AMOUNT_DESC,
+        makePartitionedView<Contract>(Contract::STATUS, Contract::AMOUNT, greater<>()));
+    contractRepo.attachIndex(CONTRACTS_BY_STATUS_DURATION_DESC,
+        makePartitionedView<Contract>(Contract::STATUS, Contract::DURATION, greater<>()));
+    contractRepo.attachIndex(CONTRACTS_BY_MANAGER_AMOUNT_DESC,
+        makePartitionedView<Contract>(Contract::MANAGER, Contract::AMOUNT, greater<>()));
+    contractRepo.attachIndex(CONTRACTS_BY_MANAGER_DURATION_DESC,
+        makePartitionedView<Contract>(Contract::MANAGER, Contract::DURATION, greater<>()));
+    clientRepo.attachIndex(CLIENTS_COMPANY_TEXT, makeTrigramIndex<Client>(Client::COMPANY_NAME));
+    objectRepo.attachIndex(OBJECTS_TYPE_TEXT, makeTrigramIndex<ConstructionObject>(ConstructionObject::TYPE));
+    contractRepo.attachIndex(CONTRACTS_MANAGER_TEXT, makeTrigramIndex<Contract>(Contract::MANAGER));
+    contractRepo.attachIndex(CONTRACTS_BY_CLIENT, makeHashIndex<Contract>(Contract::CLIENT_ID));
+    contractRepo.attachIndex(CONTRACTS_BY_OBJECT, makeHashIndex<Contract>(Contract::OBJECT_ID));
+    contractRepo.attachIndex(CONTRACTS_BY_MANAGER, makeHashIndex<Contract>(Contract::MANAGER));
+    contractRepo.attachIndex(CONTRACTS_STATUS_BITMAP, makeBitmapIndex<Contract>(Contract::STATUS));
+    contractRepo.attachIndex(CONTRACTS_WORK_TYPE_BITMAP, makeBitmapIndex<Contract>(Contract::WORK_TYPE));
+    objectRepo.attachIndex(OBJECTS_TYPE_BITMAP, makeBitmapIndex<ConstructionObject>(ConstructionObject::TYPE));
+
+    //  ,   
+    auto usersLoaded = async(launch::async, [] { userRepo.loadFromFile(); });
+    auto clientsLoaded = async(launch::async, [] { clientRepo.loadFromFile(); });
+    auto objectsLoaded = async(launch::async, [] { objectRepo.loadFromFile(); });
+    auto contractsLoaded = async(launch::async, [] { contractRepo.loadFromFile(); });
+    usersLoaded.get();
+    clientsLoaded.get();
+    objectsLoaded.get();
+    contractsLoaded.get();
 
     if (userRepo.size() == 0) {
         userRepo.add(make_shared<User>(1, "admin", "admin123", true));
@@ -108,8 +389,8 @@ void initData() {
     }
 
     if (contractRepo.size() == 0) {
-        contractRepo.add(make_shared<Contract>(1, 1, 1, Date(15, 3, 2024), 180, 250000.0, "  ", " ", " .."));
-        contractRepo.add(make_shared<Contract>(2, 2, 2, Date(1, 4, 2024), 120, 180000.0, " ", "", " .."));
+        contractRepo.add(make_shared<Contract>(1, 1, 1, Date(15, 3, 2024), 180, Money::fromUnits(250000), "  ", " ", " .."));
+        contractRepo.add(make_shared<Contract>(2, 2, 2, Date(1, 4, 2024), 120, Money::fromUnits(180000), " ", "", " .."));
         contractRepo.saveToFile();
     }
 }
@@ -132,7 +413,7 @@ void menu() {
         case 2: {
             string login = safeInputLogin(": ");
             string password = safeInputString(": ");
-            int newId = getNextId(userRepo);
+            int newId = userRepo.allocateId();
             userRepo.add(make_shared<User>(newId, login, password, false));
             userRepo.saveToFile();
             cout << " !" << endl;
@@ -149,23 +430,25 @@ void signIn() {
     string login = safeInputLogin(": ");
     string password = safeInputString(": ");
 
-    auto users = userRepo.findAll();
-    for (const auto& user : users) {
-        if (user->getLogin() == login && user->checkPassword(password)) {
-            cout << " , " << login << "!" << endl;
-            if (user->getIsAdmin()) {
-                adminMenu(user);
-            }
-            else {
-                userMenu(user);
-            }
-            return;
-        }
+    const User* found = userRepo.findFirst([&](const User& candidate) {
+        return candidate.getLogin() == login && candidate.checkPassword(password);
+        });
+    if (!found) {
+        cout << "   !" << endl;
+        return;
+    }
+    // :      ,   
+    User user = *found;
+    cout << " , " << login << "!" << endl;
+    if (user.getIsAdmin()) {
+        adminMenu(user);
+    }
+    else {
+        userMenu(user);
     }
-    cout << "   !" << endl;
 }
 
-void userMenu(shared_ptr<User> user) {
+void userMenu(const User& user) {
     int choice;
     do {
         cout << "\n__________ __________" << endl;
@@ -173,24 +456,22 @@ void userMenu(shared_ptr<User> user) {
         cout << "2.  " << endl;
         cout << "3.  " << endl;
         cout << "4.   " << endl;
+        cout << "5. " << endl;
         cout << "0. " << endl;
 
-        choice = safeInputInt(" : ", 0, 4);
-
-        auto contracts = contractRepo.findAll();
+        choice = safeInputInt(" : ", 0, 5);
 
         switch (choice) {
         case 1:
             cout << "\n :\n";
-            for (const auto& contract : contracts) {
-                contract->display();
+            for (const Contract& contract : contractRepo.view()) {
+                contract.display();
             }
             break;
         case 2: {
             string status = selectStatusForSearch();
-            auto results = contractRepo.search([status](const shared_ptr<Contract>& c) {
-                return c->getStatus() == status;
-                });
+            auto statuses = contractRepo.getIndex<ValueBitmapIndex<Contract>>(CONTRACTS_STATUS_BITMAP);
+            auto results = contractRepo.findMany(statuses->bitmap(status).toVector());
             cout << " : " << results.size() << endl;
             for (const auto& contract : results) {
                 contract->display();
@@ -198,9 +479,7 @@ void userMenu(shared_ptr<User> user) {
             break;
         }
         case 3: {
-            auto sorted = contractRepo.sort([](const shared_ptr<Contract>& a, const shared_ptr<Contract>& b) {
-                return a->getAmount() < b->getAmount();
-                });
+            auto sorted = contractRepo.ordered(CONTRACTS_BY_AMOUNT);
             cout << "    ( ):\n";
             for (const auto& contract : sorted) {
                 contract->display();
@@ -210,12 +489,15 @@ void userMenu(shared_ptr<User> user) {
         case 4:
             showMostProfitableContract();
             break;
+        case 5:
+            rankingMenu();
+            break;
         case 0: return;
         }
     } while (choice != 0);
 }
 
-void adminMenu(shared_ptr<User> user) {
+void adminMenu(const User& user) {
     int choice;
     do {
         cout << "\n__________ __________" << endl;
@@ -223,15 +505,17 @@ void adminMenu(shared_ptr<User> user) {
         cout << "2.   " << endl;
         cout << "3.  " << endl;
         cout << "4.   " << endl;
+        cout << "5. " << endl;
         cout << "0. " << endl;
 
-        choice = safeInputInt(" : ", 0, 4);
+        choice = safeInputInt(" : ", 0, 5);
 
         switch (choice) {
         case 1: handleDataMenu(); break;
         case 2: handleAccountsMenu(); break;
         case 3: generateReport(); break;
         case 4: showMostProfitableContract(); break;
+        case 5: rankingMenu(); break;
         case 0: return;
         }
     } while (choice != 0);
@@ -247,9 +531,12 @@ void handleDataMenu() {
         cout << "4.  " << endl;
         cout << "5.  " << endl;
         cout << "6.  " << endl;
+        cout << "7.     " << endl;
+        cout << "8.     " << endl;
+        cout << "9.    " << endl;
         cout << "0. " << endl;
 
-        choice = safeInputInt(" : ", 0, 6);
+        choice = safeInputInt(" : ", 0, 9);
 
         switch (choice) {
         case 1: printDataMenu(); break;
@@ -258,6 +545,9 @@ void handleDataMenu() {
         case 4: changeDataMenu(); break;
         case 5: searchDataMenu(); break;
         case 6: sortDataMenu(); break;
+        case 7: exportDataMenu(); break;
+        case 8: importDataMenu(); break;
+        case 9: storageFormatMenu(); break;
         case 0: return;
         }
     } while (choice != 0);
@@ -277,20 +567,20 @@ void printDataMenu() {
         switch (choice) {
         case 1:
             cout << "\n:\n";
-            for (const auto& client : clientRepo.findAll()) {
-                client->display();
+            for (const Client& client : clientRepo.view()) {
+                client.display();
             }
             break;
         case 2:
             cout << "\n:\n";
-            for (const auto& object : objectRepo.findAll()) {
-                object->display();
+            for (const ConstructionObject& object : objectRepo.view()) {
+                object.display();
             }
             break;
         case 3:
             cout << "\n:\n";
-            for (const auto& contract : contractRepo.findAll()) {
-                contract->display();
+            for (const Contract& contract : contractRepo.view()) {
+                contract.display();
             }
             break;
         case 0: return;
@@ -311,7 +601,7 @@ void addDataMenu() {
 
         switch (choice) {
         case 1: {
-            int id = getNextId(clientRepo);
+            int id = clientRepo.allocateId();
             cout << "  ID: " << id << endl;
             string company = safeInputAlphaString(": ");
             string contact = safeInputAlphaString(" : ");
@@ -325,7 +615,7 @@ void addDataMenu() {
             break;
         }
         case 2: {
-            int id = getNextId(objectRepo);
+            int id = objectRepo.allocateId();
             cout << "  ID: " << id << endl;
             string name = safeInputAlphaString(": ");
             string address = safeInputString(": ");
@@ -341,34 +631,28 @@ void addDataMenu() {
             break;
         }
         case 3: {
-            int id = getNextId(contractRepo);
+            int id = contractRepo.allocateId();
             cout << "   : " << id << endl;
 
             //   
             cout << "\n :" << endl;
-            for (const auto& client : clientRepo.findAll()) {
-                cout << "ID: " << client->getId() << ", : " << client->getCompanyName() << endl;
+            for (const Client& client : clientRepo.view()) {
+                cout << "ID: " << client.getId() << ", : " << client.getCompanyName() << endl;
             }
             int clientId = safeInputInt("ID : ", 1, 10000);
 
             //   
             cout << "\n :" << endl;
-            for (const auto& object : objectRepo.findAll()) {
-                cout << "ID: " << object->getId() << ", : " << object->getName() << endl;
+            for (const ConstructionObject& object : objectRepo.view()) {
+                cout << "ID: " << object.getId() << ", : " << object.getName() << endl;
             }
             int objectId = safeInputInt("ID : ", 1, 10000);
 
             //       
-            string dateStr = safeInputDateString("  (  ..): ");
-            size_t dot1 = dateStr.find('.');
-            size_t dot2 = dateStr.find('.', dot1 + 1);
-            int day = stoi(dateStr.substr(0, dot1));
-            int month = stoi(dateStr.substr(dot1 + 1, dot2 - dot1 - 1));
-            int year = stoi(dateStr.substr(dot2 + 1));
-            Date date(day, month, year);
+            Date date = safeInputDate("  (  ..): ");
 
             int duration = safeInputInt(" (): ", 1, 3650);
-            double amount = safeInputDouble(": ", 0.0, 1e9);
+            Money amount = safeInputMoney(": ");
 
             //     
             string workType = selectWorkType();
@@ -403,7 +687,11 @@ void deleteDataMenu() {
         switch (choice) {
         case 1:
             id = safeInputInt("ID : ", 1, 10000);
-            if (clientRepo.remove(id)) {
+            if (size_t linked = contractRepo.idsByKey(CONTRACTS_BY_CLIENT, id).size()) {
+                cout << "  :     - " << linked
+                    << ".    ." << endl;
+            }
+            else if (clientRepo.remove(id)) {
                 clientRepo.saveToFile();
                 cout << " !" << endl;
             }
@@ -413,7 +701,11 @@ void deleteDataMenu() {
             break;
         case 2:
             id = safeInputInt("ID : ", 1, 10000);
-            if (objectRepo.remove(id)) {
+            if (size_t linked = contractRepo.idsByKey(CONTRACTS_BY_OBJECT, id).size()) {
+                cout << "  :     - " << linked
+                    << ".    ." << endl;
+            }
+            else if (objectRepo.remove(id)) {
                 objectRepo.saveToFile();
                 cout << " !" << endl;
             }
@@ -459,39 +751,39 @@ void changeDataMenu() {
 void editClient() {
     int id = safeInputInt(" ID   : ", 1, 10000);
 
-    auto client = clientRepo.find(id);
-    if (!client) {
-        cout << "  ." << endl;
-        return;
-    }
-
-    client->display();
+    bool found = clientRepo.update(id, [](Client& client) {
+        client.display();
 
-    string newName, newContact, newPhone, newEmail, newAddress;
+        string newName, newContact, newPhone, newEmail, newAddress;
 
-    cout << "    (: " << client->getCompanyName() << ", Enter  ): ";
-    getline(cin, newName);
-    if (!newName.empty() && isValidAlphaString(newName)) client->setCompanyName(newName);
-    else if (!newName.empty()) cout << "  !" << endl;
+        cout << "    (: " << client.getCompanyName() << ", Enter  ): ";
+        getline(cin, newName);
+        if (!newName.empty() && isValidAlphaString(newName)) client.setCompanyName(newName);
+        else if (!newName.empty()) cout << "  !" << endl;
 
-    cout << "    (: " << client->getContactPerson() << ", Enter  ): ";
-    getline(cin, newContact);
-    if (!newContact.empty() && isValidAlphaString(newContact)) client->setContactPerson(newContact);
-    else if (!newContact.empty()) cout << "  !" << endl;
+        cout << "    (: " << client.getContactPerson() << ", Enter  ): ";
+        getline(cin, newContact);
+        if (!newContact.empty() && isValidAlphaString(newContact)) client.setContactPerson(newContact);
+        else if (!newContact.empty()) cout << "  !" << endl;
 
-    cout << "   (: " << client->getPhone() << ", Enter  ): ";
-    getline(cin, newPhone);
-    if (!newPhone.empty() && isValidPhone(newPhone)) client->setPhone(newPhone);
-    else if (!newPhone.empty()) cout << " !" << endl;
+        cout << "   (: " << client.getPhone() << ", Enter  ): ";
+        getline(cin, newPhone);
+        if (!newPhone.empty() && isValidPhone(newPhone)) client.setPhone(newPhone);
+        else if (!newPhone.empty()) cout << " !" << endl;
 
-    cout << "  email (: " << client->getEmail() << ", Enter  ): ";
-    getline(cin, newEmail);
-    if (!newEmail.empty() && isValidEmail(newEmail)) client->setEmail(newEmail);
-    else if (!newEmail.empty()) cout << " email!" << endl;
+        cout << "  email (: " << client.getEmail() << ", Enter  ): ";
+        getline(cin, newEmail);
+        if (!newEmail.empty() && isValidEmail(newEmail)) client.setEmail(newEmail);
+        else if (!newEmail.empty()) cout << " email!" << endl;
 
-    cout << "   (: " << client->getAddress() << ", Enter  ): ";
-    getline(cin, newAddress);
-    if (!newAddress.empty()) client->setAddress(newAddress);
+        cout << "   (: " << client.getAddress() << ", Enter  ): ";
+        getline(cin, newAddress);
+        if (!newAddress.empty()) client.setAddress(newAddress);
+        });
+    if (!found) {
+        cout << "  ." << endl;
+        return;
+    }
 
     clientRepo.saveToFile();
     cout << "  !" << endl;
@@ -500,52 +792,52 @@ void editClient() {
 void editObject() {
     int id = safeInputInt(" ID   : ", 1, 10000);
 
-    auto object = objectRepo.find(id);
-    if (!object) {
-        cout << "  ." << endl;
-        return;
-    }
-
-    object->display();
+    bool found = objectRepo.update(id, [](ConstructionObject& object) {
+        object.display();
 
-    string newName, newAddress, newType;
-    double newArea;
+        string newName, newAddress, newType;
+        double newArea;
 
-    cout << "   (: " << object->getName() << ", Enter  ): ";
-    getline(cin, newName);
-    if (!newName.empty() && isValidAlphaString(newName)) object->setName(newName);
-    else if (!newName.empty()) cout << " !" << endl;
+        cout << "   (: " << object.getName() << ", Enter  ): ";
+        getline(cin, newName);
+        if (!newName.empty() && isValidAlphaString(newName)) object.setName(newName);
+        else if (!newName.empty()) cout << " !" << endl;
 
-    cout << "   (: " << object->getAddress() << ", Enter  ): ";
-    getline(cin, newAddress);
-    if (!newAddress.empty()) object->setAddress(newAddress);
+        cout << "   (: " << object.getAddress() << ", Enter  ): ";
+        getline(cin, newAddress);
+        if (!newAddress.empty()) object.setAddress(newAddress);
 
-    //       
-    cout << "  ? (1 - , 0 - ): ";
-    int changeType = safeInputInt("", 0, 1);
-    if (changeType == 1) {
-        newType = selectObjectTypeForEdit(object->getType());
-        object->setType(newType);
-    }
+        //       
+        cout << "  ? (1 - , 0 - ): ";
+        int changeType = safeInputInt("", 0, 1);
+        if (changeType == 1) {
+            newType = selectObjectTypeForEdit(object.getType());
+            object.setType(newType);
+        }
 
-    cout << "   (: " << object->getArea() << ", 0 - ): ";
-    string areaInput;
-    getline(cin, areaInput);
-    if (!areaInput.empty()) {
-        try {
-            size_t pos;
-            newArea = stod(areaInput, &pos);
-            // ,       
-            if (pos == areaInput.length() && newArea > 0) {
-                object->setArea(newArea);
+        cout << "   (: " << object.getArea() << ", 0 - ): ";
+        string areaInput;
+        getline(cin, areaInput);
+        if (!areaInput.empty()) {
+            try {
+                size_t pos;
+                newArea = stod(areaInput, &pos);
+                // ,       
+                if (pos == areaInput.length() && newArea > 0) {
+                    object.setArea(newArea);
+                }
+                else {
+                    cout << " !" << endl;
+                }
             }
-            else {
+            catch (...) {
                 cout << " !" << endl;
             }
         }
-        catch (...) {
-            cout << " !" << endl;
-        }
+        });
+    if (!found) {
+        cout << "  ." << endl;
+        return;
     }
 
     objectRepo.saveToFile();
@@ -555,92 +847,79 @@ void editObject() {
 void editContract() {
     int id = safeInputInt("    : ", 1, 10000);
 
-    auto contract = contractRepo.find(id);
-    if (!contract) {
-        cout << "  ." << endl;
-        return;
-    }
-
-    contract->display();
+    bool found = contractRepo.update(id, [](Contract& contract) {
+        contract.display();
 
-    string newWorkType, newStatus, newManager, dateInput;
-    Date newDate;
-    int newDuration;
-    double newAmount;
+        string newWorkType, newStatus, newManager, dateInput;
+        Date newDate;
+        int newDuration;
+        Money newAmount;
 
-    //       
-    cout << "  ? (1 - , 0 - ): ";
-    int changeWorkType = safeInputInt("", 0, 1);
-    if (changeWorkType == 1) {
-        newWorkType = selectWorkTypeForEdit(contract->getWorkType());
-        contract->setWorkType(newWorkType);
-    }
+        //       
+        cout << "  ? (1 - , 0 - ): ";
+        int changeWorkType = safeInputInt("", 0, 1);
+        if (changeWorkType == 1) {
+            newWorkType = selectWorkTypeForEdit(contract.getWorkType());
+            contract.setWorkType(newWorkType);
+        }
 
-    //      
-    cout << " ? (1 - , 0 - ): ";
-    int changeStatus = safeInputInt("", 0, 1);
-    if (changeStatus == 1) {
-        newStatus = selectStatusForEdit(contract->getStatus());
-        contract->setStatus(newStatus);
-    }
+        //      
+        cout << " ? (1 - , 0 - ): ";
+        int changeStatus = safeInputInt("", 0, 1);
+        if (changeStatus == 1) {
+            newStatus = selectStatusForEdit(contract.getStatus());
+            contract.setStatus(newStatus);
+        }
 
-    cout << "   (: " << contract->getManager() << ", Enter  ): ";
-    getline(cin, newManager);
-    if (!newManager.empty() && isValidAlphaString(newManager)) contract->setManager(newManager);
-    else if (!newManager.empty()) cout << "  !" << endl;
+        cout << "   (: " << contract.getManager() << ", Enter  ): ";
+        getline(cin, newManager);
+        if (!newManager.empty() && isValidAlphaString(newManager)) contract.setManager(newManager);
+        else if (!newManager.empty()) cout << "  !" << endl;
 
-    cout << "    (  .., Enter  ): ";
-    getline(cin, dateInput);
-    if (!dateInput.empty() && isValidDateString(dateInput)) {
-        size_t dot1 = dateInput.find('.');
-        size_t dot2 = dateInput.find('.', dot1 + 1);
-        int day = stoi(dateInput.substr(0, dot1));
-        int month = stoi(dateInput.substr(dot1 + 1, dot2 - dot1 - 1));
-        int year = stoi(dateInput.substr(dot2 + 1));
-        contract->setStartDate(Date(day, month, year));
-    }
-    else if (!dateInput.empty()) {
-        cout << " !" << endl;
-    }
+        cout << "    (  .., Enter  ): ";
+        getline(cin, dateInput);
+        if (!dateInput.empty() && Date::parse(dateInput, newDate)) {
+            contract.setStartDate(newDate);
+        }
+        else if (!dateInput.empty()) {
+            cout << " !" << endl;
+        }
 
-    cout << "   (, 0 - ): ";
-    string durationInput;
-    getline(cin, durationInput);
-    if (!durationInput.empty()) {
-        try {
-            size_t pos;
-            newDuration = stoi(durationInput, &pos);
-            // ,       
-            if (pos == durationInput.length() && newDuration > 0) {
-                contract->setDuration(newDuration);
+        cout << "   (, 0 - ): ";
+        string durationInput;
+        getline(cin, durationInput);
+        if (!durationInput.empty()) {
+            try {
+                size_t pos;
+                newDuration = stoi(durationInput, &pos);
+                // ,       
+                if (pos == durationInput.length() && newDuration > 0) {
+                    contract.setDuration(newDuration);
+                }
+                else {
+                    cout << " !" << endl;
+                }
             }
-            else {
+            catch (...) {
                 cout << " !" << endl;
             }
         }
-        catch (...) {
-            cout << " !" << endl;
-        }
-    }
 
-    cout << "   (0 - ): ";
-    string amountInput;
-    getline(cin, amountInput);
-    if (!amountInput.empty()) {
-        try {
-            size_t pos;
-            newAmount = stod(amountInput, &pos);
-            // ,       
-            if (pos == amountInput.length() && newAmount > 0) {
-                contract->setAmount(newAmount);
+        cout << "   (0 - ): ";
+        string amountInput;
+        getline(cin, amountInput);
+        if (!amountInput.empty()) {
+            if (Money::parse(amountInput, newAmount) && newAmount > Money()) {
+                contract.setAmount(newAmount);
             }
             else {
                 cout << " !" << endl;
             }
         }
-        catch (...) {
-            cout << " !" << endl;
-        }
+        });
+    if (!found) {
+        cout << "  ." << endl;
+        return;
     }
 
     contractRepo.saveToFile();
@@ -655,29 +934,27 @@ void searchDataMenu() {
         cout << "2.     " << endl;
         cout << "3.    " << endl;
         cout << "4.    " << endl;
+        cout << "5.  " << endl;
+        cout << "6.  " << endl;
+        cout << "7.   ( )" << endl;
+        cout << "8.    ,     " << endl;
+        cout << "9.     (  )" << endl;
+        cout << "10.     ( )" << endl;
+        cout << "11.     " << endl;
+        cout << "12.    " << endl;
         cout << "0. " << endl;
 
-        choice = safeInputInt(" : ", 0, 4);
+        choice = safeInputInt(" : ", 0, 12);
 
         switch (choice) {
         case 1: {
-            double minAmount = safeInputDouble("  : ", 0, 1e9);
-            auto results = contractRepo.search([minAmount](const shared_ptr<Contract>& c) {
-                return c->getAmount() >= minAmount;
-                });
-            cout << "\n    >= " << fixed << setprecision(0) << minAmount << ": " << results.size() << endl;
-            cout.unsetf(ios_base::floatfield);
-            cout << setprecision(6);
-            for (const auto& contract : results) {
-                contract->display();
-            }
+            Money minAmount = safeInputMoney("  : ");
+            showContractsByAmount(minAmount, Money::max());
             break;
         }
         case 2: {
             string companyName = safeInputAlphaString("    : ");
-            auto results = clientRepo.search([companyName](const shared_ptr<Client>& c) {
-                return c->getCompanyName().find(companyName) != string::npos;
-                });
+            auto results = clientRepo.searchText(CLIENTS_COMPANY_TEXT, companyName);
             cout << "\n      '" << companyName << "': " << results.size() << endl;
             for (const auto& client : results) {
                 client->display();
@@ -686,9 +963,7 @@ void searchDataMenu() {
         }
         case 3: {
             string objectType = safeInputAlphaString("    : ");
-            auto results = objectRepo.search([objectType](const shared_ptr<ConstructionObject>& o) {
-                return o->getType().find(objectType) != string::npos;
-                });
+            auto results = objectRepo.searchText(OBJECTS_TYPE_TEXT, objectType);
             cout << "\n     '" << objectType << "': " << results.size() << endl;
             for (const auto& object : results) {
                 object->display();
@@ -697,15 +972,60 @@ void searchDataMenu() {
         }
         case 4: {
             string managerName = safeInputAlphaString("    : ");
-            auto results = contractRepo.search([managerName](const shared_ptr<Contract>& c) {
-                return c->getManager().find(managerName) != string::npos;
-                });
+            auto results = contractRepo.searchText(CONTRACTS_MANAGER_TEXT, managerName);
             cout << "\n     '" << managerName << "': " << results.size() << endl;
             for (const auto& contract : results) {
                 contract->display();
             }
             break;
         }
+        case 5: {
+            int clientId = safeInputInt("ID : ", 1, 10000);
+            auto results = contractRepo.findByKey(CONTRACTS_BY_CLIENT, clientId);
+            cout << "\n   " << clientId << ": " << results.size() << endl;
+            for (const auto& contract : results) {
+                contract->display();
+            }
+            break;
+        }
+        case 6: {
+            int objectId = safeInputInt("ID : ", 1, 10000);
+            auto results = contractRepo.findByKey(CONTRACTS_BY_OBJECT, objectId);
+            cout << "\n    " << objectId << ": " << results.size() << endl;
+            for (const auto& contract : results) {
+                contract->display();
+            }
+            break;
+        }
+        case 7: {
+            string managerName = safeInputAlphaString("  : ");
+            auto results = contractRepo.findByKey(CONTRACTS_BY_MANAGER, managerName);
+            cout << "\n   '" << managerName << "': " << results.size() << endl;
+            for (const auto& contract : results) {
+                contract->display();
+            }
+            break;
+        }
+        case 8:
+            filterContracts();
+            break;
+        case 9: {
+            Money maxAmount = safeInputMoney("  : ");
+            showContractsByAmount(Money::min(), maxAmount);
+            break;
+        }
+        case 10: {
+            Money minAmount = safeInputMoney("  : ");
+            Money maxAmount = safeInputMoney("  : ", minAmount);
+            showContractsByAmount(minAmount, maxAmount);
+            break;
+        }
+        case 11:
+            scheduleMenu();
+            break;
+        case 12:
+            queryContracts();
+            break;
         case 0: return;
         }
     } while (choice != 0);
@@ -720,15 +1040,14 @@ void sortDataMenu() {
         cout << "3.     " << endl;
         cout << "4.     ( )" << endl;
         cout << "5.     ( )" << endl;
+        cout << "6.    ,    ( )" << endl;
         cout << "0. " << endl;
 
-        choice = safeInputInt(" : ", 0, 5);
+        choice = safeInputInt(" : ", 0, 6);
 
         switch (choice) {
         case 1: {
-            auto sorted = contractRepo.sort([](const shared_ptr<Contract>& a, const shared_ptr<Contract>& b) {
-                return a->getStartDate() < b->getStartDate();
-                });
+            auto sorted = contractRepo.ordered(CONTRACTS_BY_START);
             cout << "\n     ( ):\n";
             for (const auto& contract : sorted) {
                 contract->display();
@@ -736,9 +1055,7 @@ void sortDataMenu() {
             break;
         }
         case 2: {
-            auto sorted = contractRepo.sort([](const shared_ptr<Contract>& a, const shared_ptr<Contract>& b) {
-                return a->getAmount() > b->getAmount();
-                });
+            auto sorted = contractRepo.ordered(CONTRACTS_BY_AMOUNT_DESC);
             cout << "\n    ( ):\n";
             for (const auto& contract : sorted) {
                 contract->display();
@@ -746,9 +1063,7 @@ void sortDataMenu() {
             break;
         }
         case 3: {
-            auto sorted = clientRepo.sort([](const shared_ptr<Client>& a, const shared_ptr<Client>& b) {
-                return a->getCompanyName() < b->getCompanyName();
-                });
+            auto sorted = clientRepo.ordered(CLIENTS_BY_COMPANY);
             cout << "\n     ( ):\n";
             for (const auto& client : sorted) {
                 client->display();
@@ -756,9 +1071,7 @@ void sortDataMenu() {
             break;
         }
         case 4: {
-            auto sorted = objectRepo.sort([](const shared_ptr<ConstructionObject>& a, const shared_ptr<ConstructionObject>& b) {
-                return a->getArea() < b->getArea();
-                });
+            auto sorted = objectRepo.ordered(OBJECTS_BY_AREA);
             cout << "\n    ( ):\n";
             for (const auto& object : sorted) {
                 object->display();
@@ -766,20 +1079,83 @@ void sortDataMenu() {
             break;
         }
         case 5: {
-            auto sorted = contractRepo.sort([](const shared_ptr<Contract>& a, const shared_ptr<Contract>& b) {
-                return a->getDuration() > b->getDuration();
-                });
+            auto sorted = contractRepo.ordered(CONTRACTS_BY_DURATION_DESC);
             cout << "\n    ( ):\n";
             for (const auto& contract : sorted) {
                 contract->display();
             }
             break;
         }
+        case 6: {
+            auto sorted = contractRepo.sortBy(sortKey(Contract::STATUS), sortKey(Contract::AMOUNT, true));
+            cout << "\n   ,   -   ( ):\n";
+            for (const auto& contract : sorted) {
+                contract->display();
+            }
+            break;
+        }
         case 0: return;
         }
     } while (choice != 0);
 }
 
+void exportDataMenu() {
+    try {
+        clientRepo.exportText("clients.txt");
+        objectRepo.exportText("objects.txt");
+        contractRepo.exportText("contracts.txt");
+        cout << "    clients.txt, objects.txt, contracts.txt" << endl;
+    }
+    catch (const exception& e) {
+        cerr << " : " << e.what() << endl;
+    }
+}
+
+//    ,  
+void importDataMenu() {
+    cout << "     clients.txt, objects.txt, contracts.txt" << endl;
+    if (!safeInputInt("? (1 - , 0 - ): ", 0, 1)) {
+        return;
+    }
+    try {
+        clientRepo.importText("clients.txt");
+        objectRepo.importText("objects.txt");
+        contractRepo.importText("contracts.txt");
+        cout << ":  " << clientRepo.size() << ",  " << objectRepo.size()
+            << ",  " << contractRepo.size() << endl;
+    }
+    catch (const exception& e) {
+        cerr << " : " << e.what() << endl;
+    }
+}
+
+//   clients.dat, objects.dat  contracts.dat.    
+//  ;       
+void storageFormatMenu() {
+    bool binary = contractRepo.storageFormat() == Repository<Contract>::StorageFormat::Binary;
+    cout << " : " << (binary ? "" : "") << endl;
+    cout << "1.  (   )" << endl;
+    cout << "2.  (   )" << endl;
+    cout << "0. " << endl;
+    int choice = safeInputInt(" : ", 0, 2);
+    if (choice == 0) {
+        return;
+    }
+    bool toBinary = choice == 2;
+    try {
+        clientRepo.setStorageFormat(toBinary ? Repository<Client>::StorageFormat::Binary : Repository<Client>::StorageFormat::Text);
+        objectRepo.setStorageFormat(toBinary ? Repository<ConstructionObject>::StorageFormat::Binary : Repository<ConstructionObject>::StorageFormat::Text);
+        contractRepo.setStorageFormat(toBinary ? Repository<Contract>::StorageFormat::Binary : Repository<Contract>::StorageFormat::Text);
+        clientRepo.compactJournal();
+        objectRepo.compactJournal();
+        contractRepo.compactJournal();
+        cout << "    " << (toBinary ? "" : "") << " " << endl;
+    }
+    catch (const exception& e) {
+        cerr << " : " << e.what() << endl;
+    }
+}
+
 void generateReport() {
     try {
         ReportGenerator::generateContractsReport(contractRepo, clientRepo, objectRepo);
@@ -802,8 +1178,8 @@ void handleAccountsMenu() {
         switch (choice) {
         case 1:
             cout << "\n:\n";
-            for (const auto& user : userRepo.findAll()) {
-                user->display();
+            for (const User& user : userRepo.view()) {
+                user.display();
             }
             break;
         case 2: {
@@ -0,0 +1,150 @@
+#ifndef MONEY_H
+#define MONEY_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <charconv>
+#include <iostream>
+
+//      :    ,
+//  ,    ,    double.
+class Money {
+private:
+    int64_t minor = 0;
+
+public:
+    //   
+    static constexpr int64_t SCALE = 100;
+    //    : , 17  , , 2  
+    static constexpr size_t MAX_FORMATTED_SIZE = 21;
+    //  :    ,     UNITS_LIMIT,
+    //    UNITS_LIMIT * 10      int64
+    static constexpr int64_t UNITS_LIMIT = (std::numeric_limits<int64_t>::max() / SCALE - 10) / 10;
+
+    constexpr Money() = default;
+
+    static constexpr Money fromMinor(int64_t minorUnits) {
+        Money money;
+        money.minor = minorUnits;
+        return money;
+    }
+
+    //   
+    static constexpr Money fromUnits(int64_t units) {
+        return fromMinor(units * SCALE);
+    }
+
+    //   ;          .
+    // false  NaN,   ,     parse
+    static bool fromDouble(double value, Money& out) {
+        if (!(std::fabs(value) < static_cast<double>(UNITS_LIMIT) * 10)) return false;
+        out = fromMinor(std::llround(value * SCALE));
+        return true;
+    }
+
+    //     (" ...", " ...")
+    static constexpr Money min() { return fromMinor(std::numeric_limits<int64_t>::min()); }
+    static constexpr Money max() { return fromMinor(std::numeric_limits<int64_t>::max()); }
+
+    constexpr int64_t minorUnits() const { return minor; }
+    double toDouble() const { return static_cast<double>(minor) / SCALE; }
+
+    //    "250000", "1500.5", "99,95", "-10.00"   .
+    //       ;  
+    // ("1.23457e+06",  double    )   double.
+    static bool parse(std::string_view text, Money& out) {
+        while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) text.remove_prefix(1);
+        while (!text.empty() && (text.back() == ' ' || text.back() == '\t')) text.remove_suffix(1);
+        if (text.empty()) return false;
+
+        for (char c : text) {
+            if (c == 'e' || c == 'E') {
+                const char* begin = text.data() + (text.front() == '+' ? 1 : 0);
+                double value;
+                auto result = std::from_chars(begin, text.data() + text.size(), value);
+                if (result.ec != std::errc() || result.ptr != text.data() + text.size()) {
+                    return false;
+                }
+                return fromDouble(value, out);
+            }
+        }
+
+        size_t i = 0;
+        bool negative = false;
+        if (text[i] == '+' || text[i] == '-') {
+            negative = text[i] == '-';
+            i++;
+        }
+        int64_t units = 0;
+        size_t digits = 0;
+        for (; i < text.size() && text[i] >= '0' && text[i] <= '9'; ++i, ++digits) {
+            if (units > UNITS_LIMIT) return false;
+            units = units * 10 + (text[i] - '0');
+        }
+        int64_t cents = 0;
+        if (i < text.size() && (text[i] == '.' || text[i] == ',')) {
+            i++;
+            size_t fraction = 0;
+            for (; i < text.size() && text[i] >= '0' && text[i] <= '9'; ++i, ++fraction) {
+                if (fraction < 2) {
+                    cents = cents * 10 + (text[i] - '0');
+                }
+                else if (fraction == 2 && text[i] >= '5') {
+                    cents++; //    
+                }
+            }
+            if (fraction == 1) cents *= 10;
+            digits += fraction;
+        }
+        if (i != text.size() || digits == 0) return false;
+
+        int64_t total = units * SCALE + cents;
+        out = fromMinor(negative ? -total : total);
+        return true;
+    }
+
+    //       MAX_FORMATTED_SIZE:  ,    .
+    //    .
+    size_t format(char* out) const {
+        char* p = out;
+        uint64_t value = minor < 0 ? 0 - static_cast<uint64_t>(minor) : static_cast<uint64_t>(minor);
+        if (minor < 0) *p++ = '-';
+        p = std::to_chars(p, out + MAX_FORMATTED_SIZE, value / SCALE).ptr;
+        unsigned cents = static_cast<unsigned>(value % SCALE);
+        if (cents != 0) {
+            *p++ = '.';
+            *p++ = static_cast<char>('0' + cents / 10);
+            *p++ = static_cast<char>('0' + cents % 10);
+        }
+        return static_cast<size_t>(p - out);
+    }
+
+    std::string toString() const {
+        char buffer[MAX_FORMATTED_SIZE];
+        return std::string(buffer, format(buffer));
+    }
+
+    constexpr Money operator+(Money other) const { return fromMinor(minor + other.minor); }
+    constexpr Money operator-(Money other) const { return fromMinor(minor - other.minor); }
+    constexpr Money operator-() const { return fromMinor(-minor); }
+    Money& operator+=(Money other) { minor += other.minor; return *this; }
+    Money& operator-=(Money other) { minor -= other.minor; return *this; }
+
+    constexpr bool operator==(Money other) const { return minor == other.minor; }
+    constexpr bool operator!=(Money other) const { return minor != other.minor; }
+    constexpr bool operator<(Money other) const { return minor < other.minor; }
+    constexpr bool operator>(Money other) const { return minor > other.minor; }
+    constexpr bool operator<=(Money other) const { return minor <= other.minor; }
+    constexpr bool operator>=(Money other) const { return minor >= other.minor; }
+};
+
+inline std::ostream& operator<<(std::ostream& os, Money money) {
+    char buffer[Money::MAX_FORMATTED_SIZE];
+    return os.write(buffer, static_cast<std::streamsize>(money.format(buffer)));
+}
+
+#endif // MONEY_H
\ No newline at end of file
@@ -0,0 +1,51 @@
+#include "packed_strings.h"
+
+using namespace std;
+
+BlobArena& BlobArena::instance() {
+    //    ,    
+    //    ,    
+    static BlobArena* arena = new BlobArena();
+    return *arena;
+}
+
+char* BlobArena::allocate(size_t size) {
+    size = roundUp(size);
+    if (size > MAX_SMALL) {
+        return new char[size];
+    }
+    lock_guard<std::mutex> lock(mutex);
+    FreeBlock*& head = freeLists[size / GRANULE];
+    if (head) {
+        char* block = reinterpret_cast<char*>(head);
+        head = head->next;
+        return block;
+    }
+    if (left < size) {
+        //        
+        if (left >= GRANULE) {
+            FreeBlock* rest = reinterpret_cast<FreeBlock*>(cursor);
+            rest->next = freeLists[left / GRANULE];
+            freeLists[left / GRANULE] = rest;
+        }
+        chunks.emplace_back(new char[CHUNK_SIZE]);
+        cursor = chunks.back().get();
+        left = CHUNK_SIZE;
+    }
+    char* block = cursor;
+    cursor += size;
+    left -= size;
+    return block;
+}
+
+void BlobArena::release(char* block, size_t size) {
+    size = roundUp(size);
+    if (size > MAX_SMALL) {
+        delete[] block;
+        return;
+    }
+    lock_guard<std::mutex> lock(mutex);
+    FreeBlock* freed = reinterpret_cast<FreeBlock*>(block);
+    freed->next = freeLists[size / GRANULE];
+    freeLists[size / GRANULE] = freed;
+}
\ No newline at end of file
@@ -0,0 +1,154 @@
+#ifndef PACKED_STRINGS_H
+#define PACKED_STRINGS_H
+
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <utility>
+#include <mutex>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+//    :     CHUNK_SIZE  
+// ,         ( 8 )
+//       .   MAX_SMALL   .
+//     ,    .
+class BlobArena {
+private:
+    static constexpr size_t GRANULE = 8;
+    static constexpr size_t MAX_SMALL = 512;
+    static constexpr size_t CHUNK_SIZE = 256 * 1024;
+
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    std::vector<std::unique_ptr<char[]>> chunks;
+    char* cursor = nullptr;
+    size_t left = 0;
+    FreeBlock* freeLists[MAX_SMALL / GRANULE + 1] = {};
+    std::mutex mutex;
+
+    BlobArena() = default;
+
+    static size_t roundUp(size_t size) { return (size + GRANULE - 1) / GRANULE * GRANULE; }
+
+public:
+    BlobArena(const BlobArena&) = delete;
+    BlobArena& operator=(const BlobArena&) = delete;
+
+    static BlobArena& instance();
+
+    char* allocate(size_t size);
+    // size -   ,     allocate
+    void release(char* block, size_t size);
+};
+
+// N       :    
+//   (uint32_t),   -   ,   .
+//    ;      .
+template<size_t N>
+class PackedStrings {
+private:
+    static constexpr size_t HEADER_SIZE = N * sizeof(uint32_t);
+
+    char* blob = nullptr;
+
+    uint32_t end(size_t i) const {
+        uint32_t value;
+        std::memcpy(&value, blob + i * sizeof(uint32_t), sizeof(value));
+        return value;
+    }
+
+    size_t blobSize() const {
+        return blob ? HEADER_SIZE + end(N - 1) : 0;
+    }
+
+    void release() {
+        if (blob) {
+            BlobArena::instance().release(blob, blobSize());
+            blob = nullptr;
+        }
+    }
+
+public:
+    PackedStrings() = default;
+
+    PackedStrings(const PackedStrings& other) {
+        if (other.blob) {
+            size_t size = other.blobSize();
+            blob = BlobArena::instance().allocate(size);
+            std::memcpy(blob, other.blob, size);
+        }
+    }
+
+    PackedStrings(PackedStrings&& other) noexcept : blob(other.blob) {
+        other.blob = nullptr;
+    }
+
+    PackedStrings& operator=(const PackedStrings& other) {
+        if (this != &other) {
+            PackedStrings copy(other);
+            std::swap(blob, copy.blob);
+        }
+        return *this;
+    }
+
+    PackedStrings& operator=(PackedStrings&& other) noexcept {
+        if (this != &other) {
+            release();
+            blob = other.blob;
+            other.blob = nullptr;
+        }
+        return *this;
+    }
+
+    ~PackedStrings() {
+        release();
+    }
+
+    std::string_view get(size_t i) const {
+        if (!blob) return std::string_view();
+        uint32_t begin = i == 0 ? 0 : end(i - 1);
+        return std::string_view(blob + HEADER_SIZE + begin, end(i) - begin);
+    }
+
+    //    :     N  
+    void assign(const std::string_view (&values)[N]) {
+        size_t total = 0;
+        for (const auto& value : values) {
+            total += value.size();
+        }
+        char* fresh = nullptr;
+        if (total > 0) {
+            fresh = BlobArena::instance().allocate(HEADER_SIZE + total);
+            uint32_t offset = 0;
+            for (size_t i = 0; i < N; ++i) {
+                //      ,    
+                if (!values[i].empty()) {
+                    std::memcpy(fresh + HEADER_SIZE + offset, values[i].data(), values[i].size());
+                }
+                offset += static_cast<uint32_t>(values[i].size());
+                std::memcpy(fresh + i * sizeof(uint32_t), &offset, sizeof(offset));
+            }
+        }
+        release();
+        blob = fresh;
+    }
+
+    void set(size_t i, std::string_view value) {
+        std::string_view values[N];
+        for (size_t k = 0; k < N; ++k) {
+            values[k] = k == i ? value : get(k);
+        }
+        assign(values);
+    }
+
+    // ,      (   )
+    size_t bytes() const {
+        return blobSize();
+    }
+};
+
+#endif // PACKED_STRINGS_H
\ No newline at end of file
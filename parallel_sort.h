@@ -0,0 +1,322 @@
+#ifndef PARALLEL_SORT_H
+#define PARALLEL_SORT_H
+
+#include <vector>
+#include <array>
+#include <tuple>
+#include <string>
+#include <string_view>
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+#include <cstdint>
+#include <cstring>
+#include "thread_pool.h"
+#include "money.h"
+#include "intern_table.h"
+
+//       .   .
+//   parallelStableSort - :   ,  
+//     ,          .
+//   radixSort -  (LSD)   :   
+//        , ,    , .
+//   sortRecords -    :      
+//      ,    (, ).    ,
+//       ,  -    .
+
+//       
+constexpr size_t PARALLEL_SORT_THRESHOLD = 1 << 15;
+
+//      n 
+inline size_t sortChunkCount(size_t n) {
+    if (n < PARALLEL_SORT_THRESHOLD) return 1;
+    return std::max<size_t>(1, std::min(ThreadPool::instance().concurrency(), n / (PARALLEL_SORT_THRESHOLD / 2)));
+}
+
+// fn( , , )   [0, n),   
+template<typename Fn>
+void forEachSortChunk(size_t n, size_t chunks, Fn fn) {
+    ThreadPool::instance().parallelFor(chunks, [&](size_t c) {
+        fn(c, n * c / chunks, n * (c + 1) / chunks);
+        });
+}
+
+template<typename E, typename Less>
+void parallelStableSort(std::vector<E>& items, Less less) {
+    size_t n = items.size();
+    size_t runs = sortChunkCount(n);
+    if (runs < 2) {
+        std::stable_sort(items.begin(), items.end(), less);
+        return;
+    }
+
+    std::vector<size_t> bounds(runs + 1);
+    for (size_t i = 0; i <= runs; ++i) {
+        bounds[i] = n * i / runs;
+    }
+    forEachSortChunk(n, runs, [&](size_t, size_t begin, size_t end) {
+        std::stable_sort(items.begin() + begin, items.begin() + end, less);
+        });
+
+    std::vector<E> buffer(n);
+    std::vector<E>* from = &items;
+    std::vector<E>* to = &buffer;
+    size_t threads = ThreadPool::instance().concurrency();
+    while (bounds.size() > 2) {
+        size_t runCount = bounds.size() - 1;
+        size_t pairs = runCount / 2;
+        //     :      ,
+        //    ,        
+        size_t parts = std::max<size_t>(1, (threads + pairs - 1) / pairs);
+        size_t tasks = pairs * parts + runCount % 2;
+        ThreadPool::instance().parallelFor(tasks, [&](size_t task) {
+            if (task == pairs * parts) {
+                //      
+                std::copy(from->begin() + bounds[runCount - 1], from->end(), to->begin() + bounds[runCount - 1]);
+                return;
+            }
+            size_t pair = task / parts;
+            size_t part = task % parts;
+            auto a = from->begin() + bounds[2 * pair];
+            auto b = from->begin() + bounds[2 * pair + 1];
+            auto bEnd = from->begin() + bounds[2 * pair + 2];
+            size_t aSize = static_cast<size_t>(b - a);
+            auto aFrom = a + aSize * part / parts;
+            auto aTo = a + aSize * (part + 1) / parts;
+            auto bFrom = part == 0 ? b : std::lower_bound(b, bEnd, *aFrom, less);
+            auto bTo = part + 1 == parts ? bEnd : std::lower_bound(b, bEnd, *aTo, less);
+            auto out = to->begin() + bounds[2 * pair] + (aFrom - a) + (bFrom - b);
+            std::merge(aFrom, aTo, bFrom, bTo, out, less);
+            });
+
+        std::vector<size_t> merged;
+        for (size_t i = 0; i < bounds.size(); i += 2) {
+            merged.push_back(bounds[i]);
+        }
+        if (merged.back() != n) {
+            merged.push_back(n);
+        }
+        bounds.swap(merged);
+        std::swap(from, to);
+    }
+    if (from != &items) {
+        items.swap(buffer);
+    }
+}
+
+//    keyCount : keyOf(, k) -  ,
+//  0 - .         
+template<typename E, typename KeyOf>
+void radixSort(std::vector<E>& items, size_t keyCount, KeyOf keyOf) {
+    size_t n = items.size();
+    if (n < 2) return;
+    size_t chunks = sortChunkCount(n);
+
+    std::vector<E> buffer(n);
+    std::vector<E>* from = &items;
+    std::vector<E>* to = &buffer;
+    std::vector<std::array<size_t, 256>> counts(chunks);
+    std::vector<uint64_t> varying(chunks);
+    for (size_t k = keyCount; k-- > 0;) {
+        //  ,       
+        uint64_t first = keyOf((*from)[0], k);
+        forEachSortChunk(n, chunks, [&](size_t c, size_t begin, size_t end) {
+            uint64_t bits = 0;
+            for (size_t i = begin; i < end; ++i) {
+                bits |= keyOf((*from)[i], k) ^ first;
+            }
+            varying[c] = bits;
+            });
+        uint64_t bits = 0;
+        for (uint64_t v : varying) {
+            bits |= v;
+        }
+
+        for (unsigned shift = 0; shift < 64; shift += 8) {
+            if (((bits >> shift) & 0xFF) == 0) continue;
+            forEachSortChunk(n, chunks, [&](size_t c, size_t begin, size_t end) {
+                auto& count = counts[c];
+                count.fill(0);
+                for (size_t i = begin; i < end; ++i) {
+                    count[(keyOf((*from)[i], k) >> shift) & 0xFF]++;
+                }
+                });
+            //      :   ,  
+            //  -   ,    
+            size_t total = 0;
+            for (size_t digit = 0; digit < 256; ++digit) {
+                for (auto& count : counts) {
+                    size_t inChunk = count[digit];
+                    count[digit] = total;
+                    total += inChunk;
+                }
+            }
+            forEachSortChunk(n, chunks, [&](size_t c, size_t begin, size_t end) {
+                auto& position = counts[c];
+                for (size_t i = begin; i < end; ++i) {
+                    const E& item = (*from)[i];
+                    (*to)[position[(keyOf(item, k) >> shift) & 0xFF]++] = item;
+                }
+                });
+            std::swap(from, to);
+        }
+    }
+    if (from != &items) {
+        items.swap(buffer);
+    }
+}
+
+//      ,    ,   .
+//     (, Date)    
+template<typename V>
+struct RadixKey {
+    static constexpr bool SUPPORTED = false;
+};
+
+template<>
+struct RadixKey<int> {
+    static constexpr bool SUPPORTED = true;
+    static uint64_t encode(int value) { return static_cast<uint32_t>(value) ^ 0x80000000u; }
+};
+
+template<>
+struct RadixKey<bool> {
+    static constexpr bool SUPPORTED = true;
+    static uint64_t encode(bool value) { return value ? 1 : 0; }
+};
+
+template<>
+struct RadixKey<Money> {
+    static constexpr bool SUPPORTED = true;
+    static uint64_t encode(Money value) { return static_cast<uint64_t>(value.minorUnits()) ^ (1ull << 63); }
+};
+
+template<>
+struct RadixKey<double> {
+    static constexpr bool SUPPORTED = true;
+    static uint64_t encode(double value) {
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        //      
+        return (bits >> 63) ? ~bits : bits | (1ull << 63);
+    }
+};
+
+//  : sortKey(Contract::AMOUNT, true) -   
+template<typename F>
+struct SortKey {
+    F field;
+    bool descending;
+};
+
+template<typename F>
+SortKey<F> sortKey(F field, bool descending = false) {
+    return SortKey<F>{ field, descending };
+}
+
+//     ,    :  -  string_view
+// ( ),   -  
+inline std::string_view orderValue(const InternedString& value) {
+    return value.str();
+}
+
+inline std::string_view orderValue(const std::string& value) {
+    return value;
+}
+
+inline std::string_view orderValue(std::string_view value) {
+    return value;
+}
+
+template<typename V>
+V orderValue(const V& value) {
+    return value;
+}
+
+template<typename T, typename F>
+using OrderValueOf = decltype(orderValue(std::declval<const F&>()(std::declval<const T&>())));
+
+//  :   -   (  - ),
+//  -  
+template<typename T, typename F>
+using SortCodeOf = std::conditional_t<RadixKey<OrderValueOf<T, F>>::SUPPORTED, uint64_t, OrderValueOf<T, F>>;
+
+template<typename T, typename F>
+SortCodeOf<T, F> extractSortCode(const SortKey<F>& key, const T& item) {
+    static_assert(!std::is_same_v<std::invoke_result_t<const F&, const T&>, std::string>,
+        "       string_view");
+    using Value = OrderValueOf<T, F>;
+    if constexpr (RadixKey<Value>::SUPPORTED) {
+        uint64_t code = RadixKey<Value>::encode(orderValue(key.field(item)));
+        return key.descending ? ~code : code;
+    }
+    else {
+        return orderValue(key.field(item));
+    }
+}
+
+inline int compareSortCode(std::string_view a, std::string_view b) {
+    int order = a.compare(b);
+    return order < 0 ? -1 : (order > 0 ? 1 : 0);
+}
+
+template<typename V>
+int compareSortCode(const V& a, const V& b) {
+    return a < b ? -1 : (b < a ? 1 : 0);
+}
+
+template<typename Codes, size_t... I>
+bool sortCodesLess(const Codes& a, const Codes& b, const bool* reverse, std::index_sequence<I...>) {
+    int order = 0;
+    ((order = order != 0 ? order : (reverse[I] ? -1 : 1) * compareSortCode(std::get<I>(a), std::get<I>(b))), ...);
+    return order < 0;
+}
+
+//    ,   - ;    .
+// sortRecords(items, sortKey(Contract::STATUS), sortKey(Contract::AMOUNT, true))
+template<typename T, typename... Fields>
+void sortRecords(std::vector<const T*>& items, const SortKey<Fields>&... keys) {
+    static_assert(sizeof...(Fields) > 0, "     ");
+    size_t n = items.size();
+    size_t chunks = sortChunkCount(n);
+
+    if constexpr ((RadixKey<OrderValueOf<T, Fields>>::SUPPORTED && ...)) {
+        using Row = std::pair<std::array<uint64_t, sizeof...(Fields)>, const T*>;
+        std::vector<Row> rows(n);
+        forEachSortChunk(n, chunks, [&](size_t, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                rows[i] = Row{ { extractSortCode(keys, *items[i])... }, items[i] };
+            }
+            });
+        radixSort(rows, sizeof...(Fields), [](const Row& row, size_t k) {
+            return row.first[k];
+            });
+        forEachSortChunk(n, chunks, [&](size_t, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                items[i] = rows[i].second;
+            }
+            });
+    }
+    else {
+        using Codes = std::tuple<SortCodeOf<T, Fields>...>;
+        using Row = std::pair<Codes, const T*>;
+        std::vector<Row> rows(n);
+        forEachSortChunk(n, chunks, [&](size_t, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                rows[i] = Row{ Codes(extractSortCode(keys, *items[i])...), items[i] };
+            }
+            });
+        //        
+        const bool reverse[] = { (keys.descending && !RadixKey<OrderValueOf<T, Fields>>::SUPPORTED)... };
+        parallelStableSort(rows, [&reverse](const Row& a, const Row& b) {
+            return sortCodesLess(a.first, b.first, reverse, std::index_sequence_for<Fields...>());
+            });
+        forEachSortChunk(n, chunks, [&](size_t, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                items[i] = rows[i].second;
+            }
+            });
+    }
+}
+
+#endif // PARALLEL_SORT_H
\ No newline at end of file
@@ -0,0 +1,640 @@
+#ifndef QUERY_H
+#define QUERY_H
+
+#include "contracts.h"
+#include "bitmap_index.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <optional>
+#include <functional>
+#include <algorithm>
+#include <iterator>
+#include <sstream>
+#include <type_traits>
+#include <cmath>
+#include <cstdint>
+
+//    :     (, ,
+// ,  ),    / , ,   .
+//
+//   Query<Contract> query(contractRepo);
+//   query.where(eq(Contract::STATUS, " "))
+//       .where(between(Contract::AMOUNT, Money::fromUnits(100000), Money::max()))
+//       .orderBy(Contract::AMOUNT, true).limit(10);
+//   auto contracts = query.run();
+//   std::cout << query.explain();
+//
+//     :   ID,   
+// ,       ,  ,
+//   -   .   ,    
+//    (RepositoryIndex::fieldName).     .
+//       ;   
+// run()   .       ,
+//  explain()  run()    .
+
+// ,      
+struct AccessPath {
+    std::string description; //  explain
+    size_t estimate;         //   
+    std::function<std::vector<int>()> fetch; // ID ;     
+};
+
+//     
+inline void keepCheaper(std::optional<AccessPath>& best, AccessPath candidate) {
+    if (!best || candidate.estimate < best->estimate) {
+        best = std::move(candidate);
+    }
+}
+
+//      .   
+//  ,          
+inline bool queryEquals(const InternedString& value, const std::string& key) {
+    return value.str() == key;
+}
+
+template<typename V, typename K>
+bool queryEquals(const V& value, const K& key) {
+    return value == key;
+}
+
+inline std::string_view queryText(const InternedString& value) {
+    return value.str();
+}
+
+inline std::string_view queryText(const std::string& value) {
+    return value;
+}
+
+inline std::string_view queryText(std::string_view value) {
+    return value;
+}
+
+//    
+inline std::string describeValue(const Date& value) {
+    return value.toString();
+}
+
+inline std::string describeValue(const std::string& value) {
+    return "\"" + value + "\"";
+}
+
+template<typename V>
+std::string describeValue(const V& value) {
+    std::ostringstream out;
+    out << value;
+    return out.str();
+}
+
+//  ,     F    
+template<typename F>
+using QueryKeyOf = IndexKeyOf<typename F::Owner, F>;
+
+//  ,    field: fn(, )
+template<typename T, typename Fn>
+void forEachFieldIndex(const Repository<T>& repo, std::string_view field, Fn fn) {
+    repo.forEachIndex([&](const std::string& name, const RepositoryIndex<T>& index) {
+        if (!field.empty() && index.fieldName() == field) {
+            fn(name, index);
+        }
+        });
+}
+
+//  = 
+template<typename F>
+struct EqualCondition {
+    using Key = QueryKeyOf<F>;
+
+    F field;
+    Key key;
+
+    template<typename T>
+    bool matches(const T& item) const {
+        return queryEquals(field(item), key);
+    }
+
+    template<typename T>
+    std::optional<AccessPath> plan(const Repository<T>& repo) const {
+        std::optional<AccessPath> best;
+        if constexpr (std::is_same_v<Key, int>) {
+            if (nameOfField(field) == "id") {
+                int id = key;
+                //  ID    
+                return AccessPath{ "  ID", repo.find(id) ? 1u : 0u, [id]() {
+                    return std::vector<int>{ id };
+                    } };
+            }
+        }
+        forEachFieldIndex(repo, nameOfField(field), [&](const std::string& name, const RepositoryIndex<T>& index) {
+            if (auto secondary = dynamic_cast<const SecondaryIndex<T, Key>*>(&index)) {
+                Key value = key;
+                keepCheaper(best, AccessPath{ "  " + name, secondary->count(key), [secondary, value]() {
+                    return secondary->lookup(value);
+                    } });
+            }
+            else if (auto ordered = dynamic_cast<const RangeIndex<T, Key>*>(&index)) {
+                Key value = key;
+                keepCheaper(best, AccessPath{ "  " + name, ordered->countRange(key, key), [ordered, value]() {
+                    return ordered->rangeIds(value, value);
+                    } });
+            }
+            if constexpr (std::is_same_v<Key, std::string>) {
+                if (auto bitmaps = dynamic_cast<const ValueBitmapIndex<T>*>(&index)) {
+                    Key value = key;
+                    keepCheaper(best, AccessPath{ "  " + name, bitmaps->bitmap(key).cardinality(), [bitmaps, value]() {
+                        return bitmaps->bitmap(value).toVector();
+                        } });
+                }
+            }
+            });
+        return best;
+    }
+
+    std::string describe() const {
+        return std::string(nameOfField(field)) + " = " + describeValue(key);
+    }
+};
+
+template<typename F, typename V>
+EqualCondition<F> eq(F field, const V& value) {
+    return EqualCondition<F>{ field, QueryKeyOf<F>(value) };
+}
+
+// lo <=  <= hi
+template<typename F>
+struct RangeCondition {
+    using Key = QueryKeyOf<F>;
+
+    F field;
+    Key lo;
+    Key hi;
+
+    template<typename T>
+    bool matches(const T& item) const {
+        const auto& value = field(item);
+        return !(value < lo) && !(hi < value);
+    }
+
+    template<typename T>
+    std::optional<AccessPath> plan(const Repository<T>& repo) const {
+        std::optional<AccessPath> best;
+        forEachFieldIndex(repo, nameOfField(field), [&](const std::string& name, const RepositoryIndex<T>& index) {
+            if (auto ordered = dynamic_cast<const RangeIndex<T, Key>*>(&index)) {
+                //     :    
+                Key from = ordered->descending() ? hi : lo;
+                Key to = ordered->descending() ? lo : hi;
+                keepCheaper(best, AccessPath{ "  " + name, ordered->countRange(from, to), [ordered, from, to]() {
+                    return ordered->rangeIds(from, to);
+                    } });
+            }
+            });
+        return best;
+    }
+
+    std::string describe() const {
+        return std::string(nameOfField(field)) + "  " + describeValue(lo) + "  " + describeValue(hi);
+    }
+};
+
+template<typename F, typename V>
+RangeCondition<F> between(F field, const V& lo, const V& hi) {
+    return RangeCondition<F>{ field, QueryKeyOf<F>(lo), QueryKeyOf<F>(hi) };
+}
+
+//    (  ,    )
+template<typename F>
+struct ContainsCondition {
+    F field;
+    std::string pattern;
+
+    template<typename T>
+    bool matches(const T& item) const {
+        return queryText(field(item)).find(pattern) != std::string_view::npos;
+    }
+
+    template<typename T>
+    std::optional<AccessPath> plan(const Repository<T>& repo) const {
+        std::optional<AccessPath> best;
+        forEachFieldIndex(repo, nameOfField(field), [&](const std::string& name, const RepositoryIndex<T>& index) {
+            if (auto text = dynamic_cast<const TextIndex<T>*>(&index)) {
+                std::string value = pattern;
+                keepCheaper(best, AccessPath{ "  " + name, text->estimateMatches(pattern), [text, value]() {
+                    return text->match(value);
+                    } });
+            }
+            });
+        return best;
+    }
+
+    std::string describe() const {
+        return std::string(nameOfField(field)) + "  " + describeValue(pattern);
+    }
+};
+
+template<typename F>
+ContainsCondition<F> contains(F field, const std::string& pattern) {
+    return ContainsCondition<F>{ field, pattern };
+}
+
+//  [start, start + duration)     from  to 
+template<typename Start, typename Duration>
+struct OverlapCondition {
+    Start start;
+    Duration duration;
+    Date from;
+    Date to;
+
+    template<typename T>
+    bool matches(const T& item) const {
+        int begin = start(item).toDayNumber();
+        int end = begin + duration(item);
+        //             
+        return end > begin && begin <= to.toDayNumber() && end > from.toDayNumber();
+    }
+
+    template<typename T>
+    std::optional<AccessPath> plan(const Repository<T>& repo) const {
+        std::optional<AccessPath> best;
+        forEachFieldIndex(repo, nameOfField(start), [&](const std::string& name, const RepositoryIndex<T>& index) {
+            if (auto periods = dynamic_cast<const PeriodIndex<T>*>(&index)) {
+                int first = from.toDayNumber();
+                int end = to.toDayNumber() + 1;
+                keepCheaper(best, AccessPath{ "  " + name, periods->countOverlapping(first, end), [periods, first, end]() {
+                    return periods->overlapping(first, end);
+                    } });
+            }
+            });
+        return best;
+    }
+
+    std::string describe() const {
+        return " (" + std::string(nameOfField(start)) + ", " + std::string(nameOfField(duration)) +
+            ")   " + describeValue(from) + " - " + describeValue(to);
+    }
+};
+
+template<typename Start, typename Duration>
+OverlapCondition<Start, Duration> overlaps(Start start, Duration duration, const Date& from, const Date& to) {
+    return OverlapCondition<Start, Duration>{ start, duration, from, to };
+}
+
+//     .  ,      
+//  :  -    
+template<typename... Conditions>
+struct AnyOfCondition {
+    std::tuple<Conditions...> conditions;
+
+    template<typename T>
+    bool matches(const T& item) const {
+        return std::apply([&item](const auto&... condition) {
+            return (condition.matches(item) || ...);
+            }, conditions);
+    }
+
+    template<typename T>
+    std::optional<AccessPath> plan(const Repository<T>& repo) const {
+        std::vector<AccessPath> paths;
+        bool complete = true;
+        std::apply([&](const auto&... condition) {
+            ((complete = complete && collect(condition.plan(repo), paths)), ...);
+            }, conditions);
+        if (!complete) {
+            return std::nullopt;
+        }
+        AccessPath united{ ":", 0, nullptr };
+        for (const auto& path : paths) {
+            united.description += " [" + path.description + "]";
+            united.estimate += path.estimate;
+        }
+        united.fetch = [paths]() {
+            std::vector<int> ids;
+            for (const auto& path : paths) {
+                std::vector<int> part = path.fetch();
+                ids.insert(ids.end(), part.begin(), part.end());
+            }
+            std::sort(ids.begin(), ids.end());
+            ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+            return ids;
+        };
+        return united;
+    }
+
+    std::string describe() const {
+        std::string text;
+        std::apply([&text](const auto&... condition) {
+            ((text += (text.empty() ? "(" : "  ") + condition.describe()), ...);
+            }, conditions);
+        return text + ")";
+    }
+
+private:
+    static bool collect(std::optional<AccessPath> path, std::vector<AccessPath>& paths) {
+        if (!path) return false;
+        paths.push_back(std::move(*path));
+        return true;
+    }
+};
+
+template<typename... Conditions>
+AnyOfCondition<Conditions...> anyOf(Conditions... conditions) {
+    return AnyOfCondition<Conditions...>{ std::make_tuple(conditions...) };
+}
+
+//    (   anyOf);  -     
+template<typename... Conditions>
+struct AllOfCondition {
+    std::tuple<Conditions...> conditions;
+
+    template<typename T>
+    bool matches(const T& item) const {
+        return std::apply([&item](const auto&... condition) {
+            return (condition.matches(item) && ...);
+            }, conditions);
+    }
+
+    template<typename T>
+    std::optional<AccessPath> plan(const Repository<T>& repo) const {
+        std::optional<AccessPath> best;
+        std::apply([&](const auto&... condition) {
+            (consider(condition.plan(repo), best), ...);
+            }, conditions);
+        return best;
+    }
+
+    std::string describe() const {
+        std::string text;
+        std::apply([&text](const auto&... condition) {
+            ((text += (text.empty() ? "(" : "  ") + condition.describe()), ...);
+            }, conditions);
+        return text + ")";
+    }
+
+private:
+    static void consider(std::optional<AccessPath> path, std::optional<AccessPath>& best) {
+        if (path) keepCheaper(best, std::move(*path));
+    }
+};
+
+template<typename... Conditions>
+AllOfCondition<Conditions...> allOf(Conditions... conditions) {
+    return AllOfCondition<Conditions...>{ std::make_tuple(conditions...) };
+}
+
+template<typename T>
+class Query {
+private:
+    //   ;      
+    struct Condition {
+        virtual ~Condition() = default;
+        virtual bool matches(const T& item) const = 0;
+        virtual std::optional<AccessPath> plan(const Repository<T>& repo) const = 0;
+        virtual std::string describe() const = 0;
+    };
+
+    template<typename C>
+    struct ConditionOf : Condition {
+        C condition;
+
+        explicit ConditionOf(C condition) : condition(std::move(condition)) {}
+
+        bool matches(const T& item) const override { return condition.matches(item); }
+        std::optional<AccessPath> plan(const Repository<T>& repo) const override { return condition.plan(repo); }
+        std::string describe() const override { return condition.describe(); }
+    };
+
+    struct Order {
+        virtual ~Order() = default;
+        virtual std::string_view field() const = 0;
+        virtual bool descending() const = 0;
+        //   -   ,   
+        virtual void sort(std::vector<const T*>& items) const = 0;
+    };
+
+    template<typename F>
+    struct OrderOf : Order {
+        F fieldOf;
+        bool reverse;
+
+        OrderOf(F fieldOf, bool reverse) : fieldOf(fieldOf), reverse(reverse) {}
+
+        std::string_view field() const override { return nameOfField(fieldOf); }
+        bool descending() const override { return reverse; }
+
+        void sort(std::vector<const T*>& items) const override {
+            //  :       
+            sortRecords(items, sortKey(fieldOf, reverse));
+        }
+    };
+
+    enum class Access { Scan, Index, OrderedScan };
+
+    struct Plan {
+        Access access = Access::Scan;
+        std::optional<AccessPath> path;
+        const OrderedIndex<T>* orderedIndex = nullptr;
+        std::string orderedName;
+        double cost = 0;
+        size_t estimate = 0; //   ,    
+    };
+
+    //       
+    static constexpr size_t ORDERED_PAGE = 256;
+
+    const Repository<T>& repo;
+    std::vector<std::shared_ptr<const Condition>> conditions;
+    std::shared_ptr<const Order> order;
+    size_t skip = 0;
+    size_t take = SIZE_MAX;
+    //     ,     (. currentPlan).
+    // -    Query      
+    mutable std::optional<Plan> cachedPlan;
+    mutable size_t plannedRevision = 0;
+
+    static double sortCost(size_t n) {
+        return n > 1 ? static_cast<double>(n) * std::log2(static_cast<double>(n)) : 0.0;
+    }
+
+    //   ID   shared_ptr   
+    const T* record(int id) const {
+        return repo.get(repo.handleOf(id));
+    }
+
+    bool matchesAll(const T& item) const {
+        for (const auto& condition : conditions) {
+            if (!condition->matches(item)) return false;
+        }
+        return true;
+    }
+
+    //   -       ,   
+    Plan choosePlan() const {
+        size_t total = repo.size();
+        Plan plan;
+        plan.estimate = total;
+        plan.cost = static_cast<double>(total) + (order ? sortCost(total) : 0.0);
+
+        std::optional<AccessPath> best;
+        for (const auto& condition : conditions) {
+            if (auto path = condition->plan(repo)) {
+                keepCheaper(best, std::move(*path));
+            }
+        }
+        if (best) {
+            double cost = static_cast<double>(best->estimate) + (order ? sortCost(best->estimate) : 0.0);
+            if (cost <= plan.cost) {
+                plan.access = Access::Index;
+                plan.cost = cost;
+                plan.estimate = best->estimate;
+                plan.path = std::move(best);
+            }
+        }
+
+        if (order) {
+            repo.forEachIndex([&](const std::string& name, const RepositoryIndex<T>& index) {
+                auto ordered = dynamic_cast<const OrderedIndex<T>*>(&index);
+                if (!ordered || index.fieldName().empty() || index.fieldName() != order->field() ||
+                    ordered->descending() != order->descending()) {
+                    return;
+                }
+                //        
+                double cost = static_cast<double>(total);
+                if (take != SIZE_MAX && plan.estimate > 0) {
+                    double needed = static_cast<double>(skip) + static_cast<double>(take);
+                    cost = std::min(cost, needed * static_cast<double>(total) / static_cast<double>(plan.estimate));
+                }
+                if (cost < plan.cost) {
+                    plan.access = Access::OrderedScan;
+                    plan.cost = cost;
+                    plan.orderedIndex = ordered;
+                    plan.orderedName = name;
+                    plan.path.reset();
+                }
+                });
+        }
+        return plan;
+    }
+
+    const Plan& currentPlan() const {
+        if (!cachedPlan || plannedRevision != repo.revision()) {
+            cachedPlan = choosePlan();
+            plannedRevision = repo.revision();
+        }
+        return *cachedPlan;
+    }
+
+public:
+    explicit Query(const Repository<T>& repo) : repo(repo) {}
+
+    //  ;     
+    template<typename C>
+    Query& where(C condition) {
+        conditions.push_back(std::make_shared<ConditionOf<C>>(std::move(condition)));
+        cachedPlan.reset();
+        return *this;
+    }
+
+    template<typename F>
+    Query& orderBy(F field, bool descending = false) {
+        order = std::make_shared<OrderOf<F>>(field, descending);
+        cachedPlan.reset();
+        return *this;
+    }
+
+    Query& offset(size_t count) {
+        skip = count;
+        cachedPlan.reset();
+        return *this;
+    }
+
+    Query& limit(size_t count) {
+        take = count;
+        cachedPlan.reset();
+        return *this;
+    }
+
+    // ,   (  ,   Repository::find)
+    std::vector<const T*> run() const {
+        const Plan& plan = currentPlan();
+        std::vector<const T*> matched;
+        //       skip + take  
+        size_t needed = take == SIZE_MAX ? SIZE_MAX : skip + take;
+
+        if (plan.access == Access::OrderedScan) {
+            for (size_t position = 0; matched.size() < needed && position < plan.orderedIndex->size(); position += ORDERED_PAGE) {
+                for (int id : plan.orderedIndex->page(position, ORDERED_PAGE)) {
+                    const T* item = record(id);
+                    if (item && matchesAll(*item)) {
+                        matched.push_back(item);
+                        if (matched.size() == needed) break;
+                    }
+                }
+            }
+        }
+        else {
+            size_t limitBeforeSort = order ? SIZE_MAX : needed;
+            auto consider = [&](const T& item) {
+                if (matched.size() < limitBeforeSort && matchesAll(item)) {
+                    matched.push_back(&item);
+                }
+            };
+            if (plan.access == Access::Index) {
+                for (int id : plan.path->fetch()) {
+                    if (const T* item = record(id)) {
+                        consider(*item);
+                    }
+                }
+            }
+            else {
+                repo.forEach(consider);
+            }
+            if (order) {
+                order->sort(matched);
+            }
+        }
+
+        std::vector<const T*> results;
+        for (size_t i = skip; i < matched.size() && results.size() < take; ++i) {
+            results.push_back(matched[i]);
+        }
+        return results;
+    }
+
+    //   :  , , ,   
+    std::string explain() const {
+        const Plan& plan = currentPlan();
+        std::ostringstream out;
+        out << "  (  : " << repo.size() << ")\n";
+        switch (plan.access) {
+        case Access::Index:
+            out << "  : " << plan.path->description << ",  : " << plan.path->estimate << "\n";
+            break;
+        case Access::OrderedScan:
+            out << "  :   " << plan.orderedName << "  ,  : "
+                << static_cast<size_t>(plan.cost) << "\n";
+            break;
+        case Access::Scan:
+            out << "  :  \n";
+            break;
+        }
+        if (!conditions.empty()) {
+            out << "  : ";
+            for (size_t i = 0; i < conditions.size(); ++i) {
+                out << (i > 0 ? "  " : "") << conditions[i]->describe();
+            }
+            out << "\n";
+        }
+        if (order) {
+            out << "  : " << order->field() << (order->descending() ? "  " : "  ")
+                << (plan.access == Access::OrderedScan ? " ( )" : " ( )") << "\n";
+        }
+        if (skip > 0 || take != SIZE_MAX) {
+            out << "  : " << skip;
+            if (take != SIZE_MAX) out << ", : " << take;
+            out << "\n";
+        }
+        return out.str();
+    }
+};
+
+#endif // QUERY_H
\ No newline at end of file
@@ -0,0 +1,145 @@
+#ifndef RECORD_PARSER_H
+#define RECORD_PARSER_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <fstream>
+#include <charconv>
+#include <cstring>
+
+//         :
+//    string_view   ,    from_chars
+class RecordParser {
+private:
+    const char* pos;
+    const char* end;
+    bool exhausted;
+
+    void skipSpaces() {
+        while (pos < end && (*pos == ' ' || *pos == '\t')) pos++;
+    }
+
+public:
+    explicit RecordParser(std::string_view line) : pos(line.data()), end(line.data() + line.size()), exhausted(false) {
+        // ,   Windows,   \r   
+        while (end > pos && (end[-1] == '\r' || end[-1] == '\n')) end--;
+    }
+
+    bool atEnd() const {
+        return exhausted || pos >= end;
+    }
+
+    //    ( )    
+    bool field(char delim, std::string_view& out) {
+        if (exhausted) return false;
+        const char* stop = static_cast<const char*>(std::memchr(pos, delim, static_cast<size_t>(end - pos)));
+        if (!stop) {
+            stop = end;
+            exhausted = true;
+        }
+        out = std::string_view(pos, static_cast<size_t>(stop - pos));
+        pos = exhausted ? end : stop + 1;
+        return true;
+    }
+
+    //   
+    bool rest(std::string_view& out) {
+        if (exhausted) return false;
+        out = std::string_view(pos, static_cast<size_t>(end - pos));
+        pos = end;
+        exhausted = true;
+        return true;
+    }
+
+    // ,  
+    bool token(std::string_view& out) {
+        skipSpaces();
+        const char* start = pos;
+        while (pos < end && *pos != ' ' && *pos != '\t') pos++;
+        out = std::string_view(start, static_cast<size_t>(pos - start));
+        return !out.empty();
+    }
+
+    // ,     
+    template<typename V>
+    bool number(V& out) {
+        skipSpaces();
+        if (pos < end && *pos == '+') pos++;
+        auto result = std::from_chars(pos, end, out);
+        if (result.ec != std::errc()) return false;
+        pos = result.ptr;
+        return true;
+    }
+
+    //    (  )
+    bool expect(char c) {
+        skipSpaces();
+        if (pos >= end || *pos != c) return false;
+        pos++;
+        return true;
+    }
+};
+
+//     ;    string_view
+//         next()
+class LineReader {
+private:
+    std::ifstream& file;
+    std::vector<char> buffer;
+    size_t begin;
+    size_t filled;
+    bool eof;
+    bool complete;
+
+    void refill() {
+        //      
+        size_t tail = filled - begin;
+        if (begin > 0 && tail > 0) {
+            std::memmove(buffer.data(), buffer.data() + begin, tail);
+        }
+        begin = 0;
+        filled = tail;
+        if (filled == buffer.size()) {
+            buffer.resize(buffer.size() * 2);
+        }
+        file.read(buffer.data() + filled, static_cast<std::streamsize>(buffer.size() - filled));
+        size_t got = static_cast<size_t>(file.gcount());
+        filled += got;
+        if (got == 0) eof = true;
+    }
+
+public:
+    explicit LineReader(std::ifstream& file, size_t bufferSize = 1 << 20)
+        : file(file), buffer(bufferSize), begin(0), filled(0), eof(false), complete(true) {
+    }
+
+    //       :  
+    //      
+    bool lineComplete() const {
+        return complete;
+    }
+
+    bool next(std::string_view& line) {
+        while (true) {
+            const char* start = buffer.data() + begin;
+            const char* newline = static_cast<const char*>(std::memchr(start, '\n', filled - begin));
+            if (newline) {
+                line = std::string_view(start, static_cast<size_t>(newline - start));
+                begin += line.size() + 1;
+                complete = true;
+                return true;
+            }
+            if (eof) {
+                if (begin == filled) return false;
+                line = std::string_view(start, filled - begin);
+                begin = filled;
+                complete = false;
+                return true;
+            }
+            refill();
+        }
+    }
+};
+
+#endif // RECORD_PARSER_H
\ No newline at end of file
@@ -0,0 +1,85 @@
+#ifndef RECORD_VIEW_H
+#define RECORD_VIEW_H
+
+#include <iterator>
+#include <cstddef>
+#include <utility>
+
+//     range-for:     ,
+//       shared_ptr.  ,
+//    
+template<typename It>
+class RecordView {
+private:
+    It first;
+    It last;
+
+public:
+    RecordView(It first, It last) : first(first), last(last) {}
+
+    It begin() const { return first; }
+    It end() const { return last; }
+    bool empty() const { return first == last; }
+};
+
+//  ,   ,   pred  true.
+//     ,    
+template<typename It, typename Pred>
+class FilteredView {
+private:
+    It first;
+    It last;
+    Pred pred;
+
+public:
+    class iterator {
+    private:
+        It current;
+        It last;
+        const Pred* pred;
+
+        void skip() {
+            while (current != last && !(*pred)(*current)) {
+                ++current;
+            }
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = typename std::iterator_traits<It>::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = typename std::iterator_traits<It>::pointer;
+        using reference = typename std::iterator_traits<It>::reference;
+
+        iterator(It current, It last, const Pred* pred) : current(current), last(last), pred(pred) {
+            skip();
+        }
+
+        reference operator*() const { return *current; }
+        pointer operator->() const { return &*current; }
+
+        iterator& operator++() {
+            ++current;
+            skip();
+            return *this;
+        }
+
+        iterator operator++(int) {
+            iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        bool operator==(const iterator& other) const { return current == other.current; }
+        bool operator!=(const iterator& other) const { return current != other.current; }
+    };
+
+    FilteredView(It first, It last, Pred pred) : first(first), last(last), pred(std::move(pred)) {}
+
+    //      :     
+    iterator begin() const { return iterator(first, last, &pred); }
+    iterator end() const { return iterator(last, last, &pred); }
+    bool empty() const { return begin() == end(); }
+};
+
+#endif // RECORD_VIEW_H
\ No newline at end of file
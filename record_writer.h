@@ -0,0 +1,92 @@
+#ifndef RECORD_WRITER_H
+#define RECORD_WRITER_H
+
+#include <string_view>
+#include <vector>
+#include <ostream>
+#include <charconv>
+#include <cstring>
+
+//     :    to_chars
+//   ,      ,  .
+//   RecordParser:   ,   .
+class RecordWriter {
+private:
+    std::ostream& out;
+    std::vector<char> buffer;
+    size_t used;
+
+    //   ,  to_chars (double   )
+    static constexpr size_t MAX_NUMBER_SIZE = 32;
+
+public:
+    static constexpr size_t DEFAULT_BUFFER_SIZE = 1 << 20;
+
+    explicit RecordWriter(std::ostream& out, size_t bufferSize = DEFAULT_BUFFER_SIZE)
+        : out(out), buffer(bufferSize), used(0) {
+    }
+
+    RecordWriter(const RecordWriter&) = delete;
+    RecordWriter& operator=(const RecordWriter&) = delete;
+
+    ~RecordWriter() {
+        flush();
+    }
+
+    //    ;      
+    void flush() {
+        if (used > 0) {
+            out.write(buffer.data(), static_cast<std::streamsize>(used));
+            used = 0;
+        }
+    }
+
+    //   size ;    commit
+    char* space(size_t size) {
+        if (buffer.size() - used < size) {
+            flush();
+            if (buffer.size() < size) {
+                buffer.resize(size);
+            }
+        }
+        return buffer.data() + used;
+    }
+
+    void commit(size_t size) {
+        used += size;
+    }
+
+    RecordWriter& text(std::string_view value) {
+        if (value.size() > buffer.size()) {
+            //     ,   
+            flush();
+            out.write(value.data(), static_cast<std::streamsize>(value.size()));
+            return *this;
+        }
+        std::memcpy(space(value.size()), value.data(), value.size());
+        commit(value.size());
+        return *this;
+    }
+
+    RecordWriter& put(char c) {
+        *space(1) = c;
+        commit(1);
+        return *this;
+    }
+
+    //    double ( ,     )
+    template<typename V>
+    RecordWriter& number(V value) {
+        char* begin = space(MAX_NUMBER_SIZE);
+        auto result = std::to_chars(begin, begin + MAX_NUMBER_SIZE, value);
+        commit(static_cast<size_t>(result.ptr - begin));
+        return *this;
+    }
+
+    //     (  ,    std::endl)
+    void endRecord() {
+        put('\n');
+    }
+};
+
+#endif // RECORD_WRITER_H
\ No newline at end of file
@@ -0,0 +1,289 @@
+#include "roaring_bitmap.h"
+#include <algorithm>
+#include <bitset>
+#include <iterator>
+
+using namespace std;
+
+static uint32_t popcount(uint64_t word) {
+    return static_cast<uint32_t>(bitset<64>(word).count());
+}
+
+bool RoaringBitmap::Container::contains(uint16_t low) const {
+    if (isBitmap()) {
+        return (words[low >> 6] >> (low & 63)) & 1;
+    }
+    return binary_search(values.begin(), values.end(), low);
+}
+
+void RoaringBitmap::Container::toBitmap() {
+    words.assign(BITMAP_WORDS, 0);
+    for (uint16_t low : values) {
+        words[low >> 6] |= uint64_t(1) << (low & 63);
+    }
+    values.clear();
+    values.shrink_to_fit();
+}
+
+void RoaringBitmap::Container::toArray() {
+    values.clear();
+    values.reserve(cardinality);
+    for (size_t w = 0; w < BITMAP_WORDS; ++w) {
+        for (uint64_t word = words[w]; word != 0; word &= word - 1) {
+            values.push_back(static_cast<uint16_t>(w * 64 + lowestBit(word)));
+        }
+    }
+    words.clear();
+    words.shrink_to_fit();
+}
+
+size_t RoaringBitmap::findContainer(uint16_t key) const {
+    auto it = lower_bound(containers.begin(), containers.end(), key,
+        [](const Container& c, uint16_t k) { return c.key < k; });
+    return static_cast<size_t>(it - containers.begin());
+}
+
+void RoaringBitmap::add(uint32_t value) {
+    uint16_t key = static_cast<uint16_t>(value >> 16);
+    uint16_t low = static_cast<uint16_t>(value);
+    size_t pos = findContainer(key);
+    if (pos == containers.size() || containers[pos].key != key) {
+        Container c;
+        c.key = key;
+        containers.insert(containers.begin() + pos, move(c));
+    }
+    Container& c = containers[pos];
+    if (c.isBitmap()) {
+        uint64_t& word = c.words[low >> 6];
+        uint64_t bit = uint64_t(1) << (low & 63);
+        if (!(word & bit)) {
+            word |= bit;
+            c.cardinality++;
+        }
+        return;
+    }
+    auto it = lower_bound(c.values.begin(), c.values.end(), low);
+    if (it != c.values.end() && *it == low) {
+        return;
+    }
+    c.values.insert(it, low);
+    c.cardinality++;
+    if (c.cardinality > ARRAY_MAX) {
+        c.toBitmap();
+    }
+}
+
+bool RoaringBitmap::remove(uint32_t value) {
+    uint16_t key = static_cast<uint16_t>(value >> 16);
+    uint16_t low = static_cast<uint16_t>(value);
+    size_t pos = findContainer(key);
+    if (pos == containers.size() || containers[pos].key != key) {
+        return false;
+    }
+    Container& c = containers[pos];
+    if (c.isBitmap()) {
+        uint64_t& word = c.words[low >> 6];
+        uint64_t bit = uint64_t(1) << (low & 63);
+        if (!(word & bit)) {
+            return false;
+        }
+        word &= ~bit;
+        c.cardinality--;
+        if (c.cardinality <= ARRAY_MAX) {
+            c.toArray();
+        }
+    }
+    else {
+        auto it = lower_bound(c.values.begin(), c.values.end(), low);
+        if (it == c.values.end() || *it != low) {
+            return false;
+        }
+        c.values.erase(it);
+        c.cardinality--;
+    }
+    if (c.cardinality == 0) {
+        containers.erase(containers.begin() + pos);
+    }
+    return true;
+}
+
+bool RoaringBitmap::contains(uint32_t value) const {
+    uint16_t key = static_cast<uint16_t>(value >> 16);
+    size_t pos = findContainer(key);
+    return pos < containers.size() && containers[pos].key == key
+        && containers[pos].contains(static_cast<uint16_t>(value));
+}
+
+size_t RoaringBitmap::cardinality() const {
+    size_t total = 0;
+    for (const Container& c : containers) {
+        total += c.cardinality;
+    }
+    return total;
+}
+
+RoaringBitmap::Container RoaringBitmap::intersect(const Container& a, const Container& b) {
+    Container result;
+    result.key = a.key;
+    if (a.isBitmap() && b.isBitmap()) {
+        result.words.resize(BITMAP_WORDS);
+        for (size_t w = 0; w < BITMAP_WORDS; ++w) {
+            result.words[w] = a.words[w] & b.words[w];
+            result.cardinality += popcount(result.words[w]);
+        }
+        if (result.cardinality <= ARRAY_MAX) {
+            result.toArray();
+        }
+        return result;
+    }
+    if (a.isBitmap() || b.isBitmap()) {
+        const Container& sparse = a.isBitmap() ? b : a;
+        const Container& dense = a.isBitmap() ? a : b;
+        for (uint16_t low : sparse.values) {
+            if (dense.contains(low)) {
+                result.values.push_back(low);
+            }
+        }
+    }
+    else {
+        set_intersection(a.values.begin(), a.values.end(), b.values.begin(), b.values.end(),
+            back_inserter(result.values));
+    }
+    result.cardinality = static_cast<uint32_t>(result.values.size());
+    return result;
+}
+
+RoaringBitmap::Container RoaringBitmap::unite(const Container& a, const Container& b) {
+    Container result;
+    result.key = a.key;
+    if (!a.isBitmap() && !b.isBitmap()) {
+        set_union(a.values.begin(), a.values.end(), b.values.begin(), b.values.end(),
+            back_inserter(result.values));
+        result.cardinality = static_cast<uint32_t>(result.values.size());
+        if (result.cardinality > ARRAY_MAX) {
+            result.toBitmap();
+        }
+        return result;
+    }
+    const Container& dense = a.isBitmap() ? a : b;
+    const Container& other = a.isBitmap() ? b : a;
+    result.words = dense.words;
+    if (other.isBitmap()) {
+        for (size_t w = 0; w < BITMAP_WORDS; ++w) {
+            result.words[w] |= other.words[w];
+        }
+    }
+    else {
+        for (uint16_t low : other.values) {
+            result.words[low >> 6] |= uint64_t(1) << (low & 63);
+        }
+    }
+    for (uint64_t word : result.words) {
+        result.cardinality += popcount(word);
+    }
+    return result;
+}
+
+RoaringBitmap::Container RoaringBitmap::subtract(const Container& a, const Container& b) {
+    Container result;
+    result.key = a.key;
+    if (!a.isBitmap()) {
+        if (b.isBitmap()) {
+            for (uint16_t low : a.values) {
+                if (!b.contains(low)) {
+                    result.values.push_back(low);
+                }
+            }
+        }
+        else {
+            set_difference(a.values.begin(), a.values.end(), b.values.begin(), b.values.end(),
+                back_inserter(result.values));
+        }
+        result.cardinality = static_cast<uint32_t>(result.values.size());
+        return result;
+    }
+    result.words = a.words;
+    if (b.isBitmap()) {
+        for (size_t w = 0; w < BITMAP_WORDS; ++w) {
+            result.words[w] &= ~b.words[w];
+        }
+    }
+    else {
+        for (uint16_t low : b.values) {
+            result.words[low >> 6] &= ~(uint64_t(1) << (low & 63));
+        }
+    }
+    for (uint64_t word : result.words) {
+        result.cardinality += popcount(word);
+    }
+    if (result.cardinality <= ARRAY_MAX) {
+        result.toArray();
+    }
+    return result;
+}
+
+RoaringBitmap RoaringBitmap::operator&(const RoaringBitmap& other) const {
+    RoaringBitmap result;
+    size_t i = 0, j = 0;
+    while (i < containers.size() && j < other.containers.size()) {
+        if (containers[i].key < other.containers[j].key) {
+            i++;
+        }
+        else if (containers[i].key > other.containers[j].key) {
+            j++;
+        }
+        else {
+            Container c = intersect(containers[i++], other.containers[j++]);
+            if (c.cardinality > 0) {
+                result.containers.push_back(move(c));
+            }
+        }
+    }
+    return result;
+}
+
+RoaringBitmap RoaringBitmap::operator|(const RoaringBitmap& other) const {
+    RoaringBitmap result;
+    size_t i = 0, j = 0;
+    while (i < containers.size() || j < other.containers.size()) {
+        if (j == other.containers.size() || (i < containers.size() && containers[i].key < other.containers[j].key)) {
+            result.containers.push_back(containers[i++]);
+        }
+        else if (i == containers.size() || containers[i].key > other.containers[j].key) {
+            result.containers.push_back(other.containers[j++]);
+        }
+        else {
+            result.containers.push_back(unite(containers[i++], other.containers[j++]));
+        }
+    }
+    return result;
+}
+
+RoaringBitmap RoaringBitmap::andNot(const RoaringBitmap& other) const {
+    RoaringBitmap result;
+    size_t j = 0;
+    for (const Container& c : containers) {
+        while (j < other.containers.size() && other.containers[j].key < c.key) {
+            j++;
+        }
+        if (j < other.containers.size() && other.containers[j].key == c.key) {
+            Container diff = subtract(c, other.containers[j]);
+            if (diff.cardinality > 0) {
+                result.containers.push_back(move(diff));
+            }
+        }
+        else {
+            result.containers.push_back(c);
+        }
+    }
+    return result;
+}
+
+vector<int> RoaringBitmap::toVector() const {
+    vector<int> result;
+    result.reserve(cardinality());
+    forEach([&result](uint32_t value) {
+        result.push_back(static_cast<int>(value));
+        });
+    return result;
+}
\ No newline at end of file
@@ -0,0 +1,97 @@
+#ifndef ROARING_BITMAP_H
+#define ROARING_BITMAP_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+//     ID   Roaring.
+//  16  ID  ,    :
+//   -   uint16_t ( 4096 ),
+//  -    1024   64 .
+// ,      ,
+//   -   .
+class RoaringBitmap {
+private:
+    static constexpr size_t ARRAY_MAX = 4096;
+    static constexpr size_t BITMAP_WORDS = 1024;
+
+    struct Container {
+        uint16_t key = 0;
+        uint32_t cardinality = 0;
+        std::vector<uint16_t> values; //  
+        std::vector<uint64_t> words;  //   (  )
+
+        bool isBitmap() const { return !words.empty(); }
+        bool contains(uint16_t low) const;
+        void toBitmap();
+        void toArray();
+    };
+
+    std::vector<Container> containers; //   key
+
+    size_t findContainer(uint16_t key) const; //      >= key
+
+    static Container intersect(const Container& a, const Container& b);
+    static Container unite(const Container& a, const Container& b);
+    static Container subtract(const Container& a, const Container& b);
+
+public:
+    void add(uint32_t value);
+    bool remove(uint32_t value);
+    bool contains(uint32_t value) const;
+    size_t cardinality() const;
+    bool empty() const { return containers.empty(); }
+    void clear() { containers.clear(); }
+
+    RoaringBitmap operator&(const RoaringBitmap& other) const;
+    RoaringBitmap operator|(const RoaringBitmap& other) const;
+    RoaringBitmap andNot(const RoaringBitmap& other) const;
+
+    //   
+    std::vector<int> toVector() const;
+
+    template<typename Fn>
+    void forEach(Fn fn) const {
+        for (const Container& c : containers) {
+            uint32_t high = static_cast<uint32_t>(c.key) << 16;
+            if (c.isBitmap()) {
+                for (size_t w = 0; w < BITMAP_WORDS; ++w) {
+                    for (uint64_t word = c.words[w]; word != 0; word &= word - 1) {
+                        fn(high | static_cast<uint32_t>(w * 64 + lowestBit(word)));
+                    }
+                }
+            }
+            else {
+                for (uint16_t low : c.values) {
+                    fn(high | low);
+                }
+            }
+        }
+    }
+
+private:
+    //     (word != 0)
+    static unsigned lowestBit(uint64_t word) {
+#if defined(_MSC_VER) && defined(_M_X64)
+        unsigned long index;
+        _BitScanForward64(&index, word);
+        return static_cast<unsigned>(index);
+#elif defined(__GNUC__)
+        return static_cast<unsigned>(__builtin_ctzll(word));
+#else
+        unsigned n = 0;
+        while ((word & 1) == 0) {
+            word >>= 1;
+            n++;
+        }
+        return n;
+#endif
+    }
+};
+
+#endif // ROARING_BITMAP_H
\ No newline at end of file
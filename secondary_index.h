@@ -0,0 +1,84 @@
+#ifndef SECONDARY_INDEX_H
+#define SECONDARY_INDEX_H
+
+#include "contracts.h"
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+
+//  -:   (getter -  T    ) -> ID    .
+//  ID       ,  .
+template<typename T, typename Getter>
+class HashIndex : public SecondaryIndex<T, IndexKeyOf<T, Getter>> {
+public:
+    using Key = IndexKeyOf<T, Getter>;
+
+private:
+    Getter getter;
+    std::unordered_map<Key, std::vector<int>> buckets;
+
+    void removeFromBucket(const Key& key, int id) {
+        auto it = buckets.find(key);
+        if (it == buckets.end()) return;
+        std::vector<int>& list = it->second;
+        auto pos = std::lower_bound(list.begin(), list.end(), id);
+        if (pos != list.end() && *pos == id) {
+            list.erase(pos);
+        }
+        if (list.empty()) {
+            buckets.erase(it);
+        }
+    }
+
+    void addToBucket(const Key& key, int id) {
+        std::vector<int>& list = buckets[key];
+        list.insert(std::upper_bound(list.begin(), list.end(), id), id);
+    }
+
+public:
+    explicit HashIndex(Getter getter) : getter(getter) {}
+
+    void onStore(const T* previous, const T& item) override {
+        Key key(std::invoke(getter, item));
+        if (previous) {
+            Key oldKey(std::invoke(getter, *previous));
+            if (oldKey == key) {
+                return;
+            }
+            removeFromBucket(oldKey, item.getId());
+        }
+        addToBucket(key, item.getId());
+    }
+
+    void onErase(const T& item) override {
+        removeFromBucket(Key(std::invoke(getter, item)), item.getId());
+    }
+
+    void onClear() override {
+        buckets.clear();
+    }
+
+    std::string_view fieldName() const override {
+        return nameOfField(getter);
+    }
+
+    const std::vector<int>& lookup(const Key& key) const override {
+        static const std::vector<int> none;
+        auto it = buckets.find(key);
+        return it != buckets.end() ? it->second : none;
+    }
+
+    size_t count(const Key& key) const override {
+        return lookup(key).size();
+    }
+};
+
+//  : makeHashIndex<Contract>(&Contract::getClientId)
+template<typename T, typename Getter>
+std::shared_ptr<HashIndex<T, Getter>> makeHashIndex(Getter getter) {
+    return std::make_shared<HashIndex<T, Getter>>(getter);
+}
+
+#endif // SECONDARY_INDEX_H
\ No newline at end of file
@@ -0,0 +1,207 @@
+#ifndef SLOT_MAP_H
+#define SLOT_MAP_H
+
+#include <vector>
+#include <memory>
+#include <optional>
+#include <iterator>
+#include <cstdint>
+#include <cstddef>
+
+//    SlotMap:     .
+//      , 
+//     .
+struct Handle {
+    uint32_t index = UINT32_MAX;
+    uint32_t generation = 0;
+
+    uint64_t pack() const {
+        return (static_cast<uint64_t>(generation) << 32) | index;
+    }
+
+    static Handle unpack(uint64_t packed) {
+        Handle h;
+        h.index = static_cast<uint32_t>(packed);
+        h.generation = static_cast<uint32_t>(packed >> 32);
+        return h;
+    }
+
+    bool operator==(const Handle& other) const {
+        return index == other.index && generation == other.generation;
+    }
+};
+
+//        .
+//    ,     
+//     .    :
+//       .
+//       (  ).
+template<typename T>
+class SlotMap {
+private:
+    static constexpr uint32_t BLOCK_SIZE = 1024;
+    static constexpr uint32_t NIL = UINT32_MAX;
+
+    struct Slot {
+        std::optional<T> value;
+        uint32_t generation = 0;
+        uint32_t prev = NIL;
+        uint32_t next = NIL; //    -  
+    };
+
+    std::vector<std::unique_ptr<Slot[]>> blocks;
+    uint32_t capacity = 0;
+    uint32_t freeHead = NIL;
+    uint32_t head = NIL;
+    uint32_t tail = NIL;
+    size_t count = 0;
+
+    Slot& slot(uint32_t index) const {
+        return blocks[index / BLOCK_SIZE][index % BLOCK_SIZE];
+    }
+
+    void grow() {
+        blocks.emplace_back(new Slot[BLOCK_SIZE]);
+        //         
+        for (uint32_t i = BLOCK_SIZE; i-- > 0;) {
+            Slot& s = slot(capacity + i);
+            s.next = freeHead;
+            freeHead = capacity + i;
+        }
+        capacity += BLOCK_SIZE;
+    }
+
+public:
+    //        .   
+    //     (   forEach)
+    class const_iterator {
+    private:
+        const SlotMap* map;
+        uint32_t index;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        const_iterator(const SlotMap* map = nullptr, uint32_t index = NIL) : map(map), index(index) {}
+
+        reference operator*() const { return *map->slot(index).value; }
+        pointer operator->() const { return &**this; }
+
+        const_iterator& operator++() {
+            index = map->slot(index).next;
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        bool operator==(const const_iterator& other) const { return index == other.index; }
+        bool operator!=(const const_iterator& other) const { return index != other.index; }
+    };
+
+    SlotMap() = default;
+    SlotMap(const SlotMap&) = delete;
+    SlotMap& operator=(const SlotMap&) = delete;
+
+    size_t size() const {
+        return count;
+    }
+
+    void reserve(size_t n) {
+        while (capacity - count < n) {
+            grow();
+        }
+    }
+
+    template<typename... Args>
+    Handle emplace(Args&&... args) {
+        if (freeHead == NIL) {
+            grow();
+        }
+        uint32_t index = freeHead;
+        Slot& s = slot(index);
+        freeHead = s.next;
+        s.value.emplace(std::forward<Args>(args)...);
+        s.prev = tail;
+        s.next = NIL;
+        if (tail != NIL) {
+            slot(tail).next = index;
+        }
+        else {
+            head = index;
+        }
+        tail = index;
+        count++;
+        return Handle{ index, s.generation };
+    }
+
+    bool erase(Handle h) {
+        if (!get(h)) {
+            return false;
+        }
+        Slot& s = slot(h.index);
+        if (s.prev != NIL) slot(s.prev).next = s.next; else head = s.next;
+        if (s.next != NIL) slot(s.next).prev = s.prev; else tail = s.prev;
+        s.value.reset();
+        s.generation++;
+        s.prev = NIL;
+        s.next = freeHead;
+        freeHead = h.index;
+        count--;
+        return true;
+    }
+
+    //     nullptr,   
+    T* get(Handle h) const {
+        if (h.index >= capacity) {
+            return nullptr;
+        }
+        Slot& s = slot(h.index);
+        return s.generation == h.generation && s.value ? &*s.value : nullptr;
+    }
+
+    //  ,      ,
+    //       
+    void clear() {
+        freeHead = head = tail = NIL;
+        for (uint32_t i = capacity; i-- > 0;) {
+            Slot& s = slot(i);
+            if (s.value) {
+                s.value.reset();
+                s.generation++;
+            }
+            s.prev = NIL;
+            s.next = freeHead;
+            freeHead = i;
+        }
+        count = 0;
+    }
+
+    const_iterator begin() const {
+        return const_iterator(this, head);
+    }
+
+    const_iterator end() const {
+        return const_iterator(this, NIL);
+    }
+
+    //     ;      fn
+    template<typename Fn>
+    void forEach(Fn fn) const {
+        for (uint32_t i = head; i != NIL;) {
+            Slot& s = slot(i);
+            uint32_t next = s.next;
+            fn(*s.value);
+            i = next;
+        }
+    }
+};
+
+#endif // SLOT_MAP_H
\ No newline at end of file
@@ -0,0 +1,329 @@
+#ifndef SORTED_VIEW_H
+#define SORTED_VIEW_H
+
+#include "contracts.h"
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+#include <cstdint>
+
+//    (, ID),     .
+//    - O(log N + LEAF_SIZE),      - O(log N)
+//      .     ID.
+template<typename Key, typename Compare = std::less<>>
+class OrderedKeyList {
+public:
+    struct Entry {
+        Key key;
+        int id;
+    };
+
+private:
+    static constexpr size_t LEAF_SIZE = 256;
+
+    std::vector<std::vector<Entry>> leaves;
+    std::vector<size_t> tree; //  :    
+    size_t count = 0;
+    Compare compare;
+
+    bool less(const Entry& a, const Entry& b) const {
+        if (compare(a.key, b.key)) return true;
+        if (compare(b.key, a.key)) return false;
+        return a.id < b.id;
+    }
+
+    //  ,      e (  )
+    size_t leafFor(const Entry& e) const {
+        size_t lo = 0, hi = leaves.size() - 1;
+        while (lo < hi) {
+            size_t mid = (lo + hi) / 2;
+            if (less(leaves[mid].back(), e)) lo = mid + 1; else hi = mid;
+        }
+        return lo;
+    }
+
+    void rebuildTree() {
+        tree.assign(leaves.size() + 1, 0);
+        for (size_t i = 1; i <= leaves.size(); ++i) {
+            tree[i] += leaves[i - 1].size();
+            size_t parent = i + (i & (0 - i));
+            if (parent <= leaves.size()) tree[parent] += tree[i];
+        }
+    }
+
+    void addCount(size_t leaf, long delta) {
+        for (size_t i = leaf + 1; i < tree.size(); i += i & (0 - i)) {
+            tree[i] += delta;
+        }
+    }
+
+    //     [0, leaf)
+    size_t prefix(size_t leaf) const {
+        size_t sum = 0;
+        for (size_t i = leaf; i > 0; i -= i & (0 - i)) {
+            sum += tree[i];
+        }
+        return sum;
+    }
+
+    //  ,   before(entry) ;    
+    //   ,    
+    template<typename Before>
+    size_t rankWhere(Before before) const {
+        size_t lo = 0, hi = leaves.size();
+        while (lo < hi) {
+            size_t mid = (lo + hi) / 2;
+            if (before(leaves[mid].back())) lo = mid + 1; else hi = mid;
+        }
+        if (lo == leaves.size()) {
+            return count;
+        }
+        const auto& entries = leaves[lo];
+        size_t inLeaf = static_cast<size_t>(std::partition_point(entries.begin(), entries.end(), before) - entries.begin());
+        return prefix(lo) + inLeaf;
+    }
+
+    //           rank (rank < count)
+    std::pair<size_t, size_t> locate(size_t rank) const {
+        size_t pos = 0;
+        size_t step = 1;
+        while (step * 2 < tree.size()) step *= 2;
+        for (; step > 0; step /= 2) {
+            if (pos + step < tree.size() && tree[pos + step] <= rank) {
+                pos += step;
+                rank -= tree[pos];
+            }
+        }
+        return { pos, rank };
+    }
+
+public:
+    size_t size() const {
+        return count;
+    }
+
+    void clear() {
+        leaves.clear();
+        tree.clear();
+        count = 0;
+    }
+
+    void insert(const Key& key, int id) {
+        Entry e{ key, id };
+        count++;
+        if (leaves.empty()) {
+            leaves.push_back({ e });
+            rebuildTree();
+            return;
+        }
+        size_t leaf = leafFor(e);
+        auto& entries = leaves[leaf];
+        entries.insert(std::upper_bound(entries.begin(), entries.end(), e,
+            [this](const Entry& a, const Entry& b) { return less(a, b); }), e);
+        if (entries.size() > 2 * LEAF_SIZE) {
+            //    
+            std::vector<Entry> upper(entries.begin() + LEAF_SIZE, entries.end());
+            entries.resize(LEAF_SIZE);
+            leaves.insert(leaves.begin() + leaf + 1, std::move(upper));
+            rebuildTree();
+        }
+        else {
+            addCount(leaf, 1);
+        }
+    }
+
+    bool erase(const Key& key, int id) {
+        if (leaves.empty()) return false;
+        Entry e{ key, id };
+        size_t leaf = leafFor(e);
+        auto& entries = leaves[leaf];
+        auto it = std::lower_bound(entries.begin(), entries.end(), e,
+            [this](const Entry& a, const Entry& b) { return less(a, b); });
+        if (it == entries.end() || it->id != id) {
+            return false;
+        }
+        entries.erase(it);
+        count--;
+        if (entries.empty()) {
+            leaves.erase(leaves.begin() + leaf);
+            rebuildTree();
+        }
+        else {
+            addCount(leaf, -1);
+        }
+        return true;
+    }
+
+    //       key
+    size_t rankBefore(const Key& key) const {
+        return rankWhere([this, &key](const Entry& e) { return compare(e.key, key); });
+    }
+
+    //       key
+    size_t rankNotAfter(const Key& key) const {
+        return rankWhere([this, &key](const Entry& e) { return !compare(key, e.key); });
+    }
+
+    //  fn   limit ,     offset;
+    //  ,  fn  false
+    template<typename Fn>
+    void forEach(size_t offset, size_t limit, Fn fn) const {
+        if (offset >= count || limit == 0) return;
+        auto start = locate(offset);
+        for (size_t leaf = start.first, pos = start.second; leaf < leaves.size(); ++leaf, pos = 0) {
+            for (; pos < leaves[leaf].size(); ++pos) {
+                if (!fn(leaves[leaf][pos]) || --limit == 0) return;
+            }
+        }
+    }
+};
+
+//  ,     (getter -  T    ).
+//     ,   ,
+//     - O(N),  - O(log N + k).
+//      k   O(log N + k),  -  O(log N).
+template<typename T, typename Getter, typename Compare = std::less<>>
+class SortedView : public RangeIndex<T, IndexKeyOf<T, Getter>> {
+public:
+    using Key = IndexKeyOf<T, Getter>;
+
+private:
+    Getter getter;
+    OrderedKeyList<Key, Compare> order;
+
+public:
+    explicit SortedView(Getter getter) : getter(getter) {}
+
+    void onStore(const T* previous, const T& item) override {
+        Key key(std::invoke(getter, item));
+        if (previous) {
+            Key oldKey(std::invoke(getter, *previous));
+            Compare compare;
+            if (!compare(oldKey, key) && !compare(key, oldKey)) {
+                return; //    
+            }
+            order.erase(oldKey, item.getId());
+        }
+        order.insert(key, item.getId());
+    }
+
+    void onErase(const T& item) override {
+        order.erase(Key(std::invoke(getter, item)), item.getId());
+    }
+
+    void onClear() override {
+        order.clear();
+    }
+
+    std::string_view fieldName() const override {
+        return nameOfField(getter);
+    }
+
+    bool descending() const override {
+        return std::is_same_v<Compare, std::greater<>>;
+    }
+
+    size_t size() const override {
+        return order.size();
+    }
+
+    std::vector<int> page(size_t offset, size_t count) const override {
+        std::vector<int> result;
+        result.reserve(std::min(count, order.size() > offset ? order.size() - offset : 0));
+        order.forEach(offset, count, [&result](const auto& entry) {
+            result.push_back(entry.id);
+            return true;
+            });
+        return result;
+    }
+
+    std::vector<int> rangeIds(const Key& lo, const Key& hi) const override {
+        size_t first = order.rankBefore(lo);
+        size_t last = order.rankNotAfter(hi);
+        return last > first ? page(first, last - first) : std::vector<int>();
+    }
+
+    size_t countRange(const Key& lo, const Key& hi) const override {
+        size_t first = order.rankBefore(lo);
+        size_t last = order.rankNotAfter(hi);
+        return last > first ? last - first : 0;
+    }
+
+    //    : fn(key, id);  ,  fn  false
+    template<typename Fn>
+    void forEach(Fn fn, size_t offset = 0, size_t count = SIZE_MAX) const {
+        order.forEach(offset, count, [&fn](const auto& entry) {
+            return fn(entry.key, entry.id);
+            });
+    }
+};
+
+// ,        
+//  groupGetter (,       ).
+//  k     O(log N + k)    .
+template<typename T, typename GroupGetter, typename Getter, typename Compare = std::less<>>
+class PartitionedView : public PartitionedIndex<T> {
+public:
+    using Key = IndexKeyOf<T, Getter>;
+
+private:
+    GroupGetter groupGetter;
+    Getter getter;
+    std::unordered_map<std::string, OrderedKeyList<Key, Compare>> groups;
+
+    void removeEntry(const T& item) {
+        auto it = groups.find(std::string(std::invoke(groupGetter, item)));
+        if (it == groups.end()) return;
+        it->second.erase(Key(std::invoke(getter, item)), item.getId());
+        if (it->second.size() == 0) {
+            groups.erase(it);
+        }
+    }
+
+public:
+    PartitionedView(GroupGetter groupGetter, Getter getter) : groupGetter(groupGetter), getter(getter) {}
+
+    void onStore(const T* previous, const T& item) override {
+        if (previous) {
+            removeEntry(*previous);
+        }
+        groups[std::string(std::invoke(groupGetter, item))].insert(Key(std::invoke(getter, item)), item.getId());
+    }
+
+    void onErase(const T& item) override {
+        removeEntry(item);
+    }
+
+    void onClear() override {
+        groups.clear();
+    }
+
+    std::vector<int> page(const std::string& group, size_t offset, size_t count) const override {
+        std::vector<int> result;
+        auto it = groups.find(group);
+        if (it != groups.end()) {
+            it->second.forEach(offset, count, [&result](const auto& entry) {
+                result.push_back(entry.id);
+                return true;
+                });
+        }
+        return result;
+    }
+};
+
+//  : makeSortedView<Contract>(&Contract::getAmount, std::greater<>())
+template<typename T, typename Getter, typename Compare = std::less<>>
+std::shared_ptr<SortedView<T, Getter, Compare>> makeSortedView(Getter getter, Compare = Compare()) {
+    return std::make_shared<SortedView<T, Getter, Compare>>(getter);
+}
+
+// makePartitionedView<Contract>(&Contract::getStatus, &Contract::getAmount, std::greater<>())
+template<typename T, typename GroupGetter, typename Getter, typename Compare = std::less<>>
+std::shared_ptr<PartitionedView<T, GroupGetter, Getter, Compare>> makePartitionedView(GroupGetter groupGetter, Getter getter, Compare = Compare()) {
+    return std::make_shared<PartitionedView<T, GroupGetter, Getter, Compare>>(groupGetter, getter);
+}
+
+#endif // SORTED_VIEW_H
\ No newline at end of file
@@ -0,0 +1,146 @@
+#include "contracts.h"
+#include "test_util.h"
+#include <cstddef>
+#include <fstream>
+
+using namespace std;
+
+static const string PATH = "binary_storage_test.dat";
+static const string CLIENT_PATH = "binary_storage_test_clients.dat";
+
+//       :   ,
+//     ,       
+static void writeLegacyContracts(uint32_t version) {
+    BinaryRecordWriter writer;
+    struct Row { int id; int day, month, year; int duration; double amount; const char* status; };
+    const Row rows[] = {
+        { 1, 29, 2, 2024, 30, 1234.56, " " },
+        { 2, 1, 1, 1970, 0, -0.255, "" },
+        { 7, 31, 12, 1899, 365, 1e12, "" },
+    };
+    for (const Row& row : rows) {
+        writer.beginRecord();
+        writer.putInt32(row.id);
+        writer.putInt32(row.id * 10);
+        writer.putInt32(row.id * 100);
+        if (version < 2) {
+            writer.putInt32(row.day);
+            writer.putInt32(row.month);
+            writer.putInt32(row.year);
+        }
+        else {
+            writer.putInt32(Date(row.day, row.month, row.year).toDayNumber());
+        }
+        writer.putInt32(row.duration);
+        writer.putDouble(row.amount);
+        writer.putString("");
+        writer.putString(row.status);
+        writer.putString(" ..");
+        writer.endRecord();
+    }
+    writer.writeTo(PATH, 10);
+
+    fstream file(PATH, ios::binary | ios::in | ios::out);
+    file.seekp(offsetof(BinaryFileHeader, version));
+    file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+}
+
+//      ,    1  2
+// ( ,   ;   double)    
+int main() {
+    {
+        Repository<Contract> contracts(PATH);
+        contracts.setStorageFormat(Repository<Contract>::StorageFormat::Binary);
+        contracts.emplace(1, 2, 3, Date(29, 2, 2024), 90, Money::fromMinor(1234567), "", " ", " ..");
+        contracts.emplace(2, 4, 5, Date(1, 1, 1900), -5, Money::fromMinor(-5), "", "", "");
+        contracts.emplace(3, 7, 8, Date(31, 12, 2099), 365, Money::fromMinor(99999999999LL), "", "", string(5000, 'x'));
+        contracts.emplace(4, 1, 1, Date(1, 1, 2024), 1, Money(), "", "", "");
+        contracts.remove(4);
+        contracts.saveToFile();
+    }
+    {
+        Repository<Contract> contracts(PATH);
+        contracts.loadFromFile();
+        CHECK(contracts.storageFormat() == Repository<Contract>::StorageFormat::Binary);
+        CHECK(contracts.size() == 3 && !contracts.find(4));
+        auto first = contracts.find(1);
+        CHECK(first && first->getClientId() == 2 && first->getObjectId() == 3);
+        CHECK(first->getStartDate() == Date(29, 2, 2024) && first->getDuration() == 90);
+        CHECK(first->getAmount() == Money::fromMinor(1234567));
+        CHECK(first->getWorkType() == "" && first->getStatus() == " " && first->getManager() == " ..");
+        auto second = contracts.find(2);
+        CHECK(second && second->getStartDate() == Date(1, 1, 1900) && second->getDuration() == -5);
+        CHECK(second->getAmount() == Money::fromMinor(-5));
+        CHECK(second->getWorkType().empty() && second->getStatus().empty() && second->getManager().empty());
+        auto third = contracts.find(3);
+        CHECK(third && third->getAmount() == Money::fromMinor(99999999999LL));
+        CHECK(third->getManager() == string(5000, 'x'));
+        //   ID   : ID    
+        CHECK(contracts.allocateId() == 5);
+
+        //      
+        contracts.emplace(5, 1, 1, Date(2, 2, 2022), 2, Money::fromUnits(2), "", "", "");
+        contracts.saveToFile();
+    }
+    {
+        Repository<Contract> contracts(PATH);
+        contracts.loadFromFile();
+        CHECK(contracts.storageFormat() == Repository<Contract>::StorageFormat::Binary);
+        CHECK(contracts.size() == 4 && contracts.find(5));
+    }
+
+    //     PackedStrings
+    {
+        Repository<Client> clients(CLIENT_PATH);
+        clients.setStorageFormat(Repository<Client>::StorageFormat::Binary);
+        clients.emplace(1, " ", " ..", "+7 900 000-00-00", "mail@example.ru", ". , . , 1");
+        clients.emplace(2, " ", "", "", "", "");
+        clients.saveToFile();
+    }
+    {
+        Repository<Client> clients(CLIENT_PATH);
+        clients.loadFromFile();
+        auto first = clients.find(1);
+        CHECK(first && first->getCompanyName() == " " && first->getContactPerson() == " ..");
+        CHECK(first->getPhone() == "+7 900 000-00-00" && first->getEmail() == "mail@example.ru");
+        CHECK(first->getAddress() == ". , . , 1");
+        auto second = clients.find(2);
+        CHECK(second && second->getCompanyName() == " " && second->getAddress().empty());
+    }
+
+    for (uint32_t version : { 1u, 2u }) {
+        writeLegacyContracts(version);
+        Repository<Contract> contracts(PATH);
+        contracts.loadFromFile();
+        CHECK(contracts.size() == 3);
+        auto first = contracts.find(1);
+        CHECK(first && first->getClientId() == 10 && first->getObjectId() == 100);
+        CHECK(first->getStartDate() == Date(29, 2, 2024) && first->getDuration() == 30);
+        CHECK(first->getAmount() == Money::fromMinor(123456));
+        CHECK(first->getWorkType() == "" && first->getStatus() == " " && first->getManager() == " ..");
+        auto second = contracts.find(2);
+        CHECK(second && second->getStartDate().toDayNumber() == 0);
+        //   double   
+        CHECK(second->getAmount() == Money::fromMinor(-26) || second->getAmount() == Money::fromMinor(-25));
+        CHECK(second->getStatus().empty());
+        auto third = contracts.find(7);
+        CHECK(third && third->getStartDate() == Date(31, 12, 1899));
+        CHECK(third->getAmount() == Money::fromUnits(1000000000000LL));
+        CHECK(contracts.allocateId() == 10);
+
+        //       
+        contracts.saveToFile();
+        MappedFile mapped;
+        CHECK(mapped.open(PATH) && mapped.isBinaryStorage());
+        CHECK(mapped.header().version == BINARY_FORMAT_VERSION);
+        mapped.close();
+        Repository<Contract> reloaded(PATH);
+        reloaded.loadFromFile();
+        CHECK(reloaded.find(7) && reloaded.find(7)->getAmount() == Money::fromUnits(1000000000000LL));
+        CHECK(reloaded.find(1)->getStartDate() == Date(29, 2, 2024));
+    }
+
+    remove(PATH.c_str());
+    remove(CLIENT_PATH.c_str());
+    return 0;
+}
\ No newline at end of file
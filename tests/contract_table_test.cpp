@@ -0,0 +1,115 @@
+#include "contract_table.h"
+#include "sorted_view.h"
+#include "test_util.h"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+using namespace std;
+
+//    32-   
+static const int64_t EDGES[] = {
+    0, 1, -1, 0xFFFFFFFFLL, 0x100000000LL, 0x7FFFFFFFLL, 0x80000000LL, -0x80000000LL, -0x100000000LL,
+    numeric_limits<int64_t>::max(), numeric_limits<int64_t>::min(), numeric_limits<int64_t>::max() - 1,
+    numeric_limits<int64_t>::min() + 1,
+};
+
+static const char* const STATUSES[] = { " ", "", "" };
+
+//   ContractTable    ,  
+//   ,      
+int main() {
+    mt19937_64 rng(7);
+    //  ,       
+    for (int count = 0; count <= 40; ++count) {
+        for (bool edges : { true, false }) {
+            Repository<Contract> contracts("contract_table_test.dat");
+            auto table = make_shared<ContractTable>();
+            contracts.attachIndex(ContractTable::INDEX_NAME, table);
+
+            vector<int64_t> amounts;
+            size_t statusCount[3] = {};
+            for (int id = 1; id <= count; ++id) {
+                //   -  ,  -    
+                int64_t amount = edges ? EDGES[rng() % size(EDGES)] : static_cast<int64_t>(rng() % 2000000) - 1000000;
+                size_t status = rng() % 3;
+                amounts.push_back(amount);
+                statusCount[status]++;
+                contracts.emplace(id, 1, 1, Date(1, 1, 2024), 30, Money::fromMinor(amount), "", STATUSES[status], "");
+            }
+
+            if (count > 0) {
+                auto maxIt = max_element(amounts.begin(), amounts.end());
+                CHECK(table->maxAmount() == Money::fromMinor(*maxIt));
+                //     -    ID
+                CHECK(table->maxAmountId() == static_cast<int>(maxIt - amounts.begin()) + 1);
+            }
+            else {
+                CHECK(table->maxAmountId() == 0);
+            }
+            if (!edges) {
+                int64_t sum = 0;
+                for (int64_t amount : amounts) {
+                    sum += amount;
+                }
+                CHECK(table->sumAmount() == Money::fromMinor(sum));
+            }
+            for (size_t k = 0; k < 3; ++k) {
+                CHECK(table->countStatus(STATUSES[k]) == statusCount[k]);
+            }
+            CHECK(table->countStatus("") == 0);
+        }
+    }
+
+    //   16-: 65537-   
+    {
+        Dictionary dictionary;
+        for (int i = 0; i <= 0xFFFF; ++i) {
+            CHECK(dictionary.encode(to_string(i)) == i);
+        }
+        CHECK_THROWS(dictionary.encode(""), runtime_error);
+        CHECK(dictionary.find("") == Dictionary::npos);
+        CHECK(dictionary.encode("65535") == 0xFFFF);
+        CHECK(dictionary.decode(0xFFFF) == "65535");
+    }
+
+    //      ,  ,   ,
+    //     -    ,   
+    {
+        Repository<Contract> contracts("contract_table_test.dat");
+        auto byAmount = makeSortedView<Contract>(Contract::AMOUNT);
+        auto table = make_shared<ContractTable>();
+        contracts.attachIndex("byAmount", byAmount);
+        contracts.attachIndex(ContractTable::INDEX_NAME, table);
+        const int count = 0x10000;
+        for (int id = 1; id <= count; ++id) {
+            contracts.emplace(id, 1, 1, Date(1, 1, 2024), 30, Money::fromUnits(id), "", " " + to_string(id), "");
+        }
+        CHECK_THROWS(contracts.emplace(count + 1, 1, 1, Date(1, 1, 2024), 30, Money::fromUnits(-5), "", "", ""),
+            runtime_error);
+        CHECK(!contracts.find(count + 1));
+        CHECK(contracts.size() == static_cast<size_t>(count) && table->size() == contracts.size());
+        CHECK(byAmount->size() == contracts.size());
+        CHECK(contracts.countRange("byAmount", Money::fromUnits(-5), Money::fromUnits(-5)) == 0);
+
+        CHECK_THROWS(contracts.update(7, [](Contract& contract) {
+            contract.setAmount(Money::fromUnits(-7));
+            contract.setStatus("");
+            }), runtime_error);
+        CHECK(contracts.find(7)->getAmount() == Money::fromUnits(7));
+        CHECK(contracts.countRange("byAmount", Money::fromUnits(-7), Money::fromUnits(-7)) == 0);
+        CHECK(contracts.countRange("byAmount", Money::fromUnits(7), Money::fromUnits(7)) == 1);
+        CHECK(table->maxAmountId() == count);
+
+        //    - 
+        contracts.update(7, [](Contract& contract) {
+            contract.setAmount(Money::fromUnits(count + 1));
+            contract.setStatus(" 1");
+            });
+        CHECK(table->maxAmountId() == 7 && table->countStatus(" 1") == 2);
+    }
+    return 0;
+}
\ No newline at end of file
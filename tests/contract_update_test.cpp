@@ -0,0 +1,107 @@
+#include "contract_table.h"
+#include "sorted_view.h"
+#include "secondary_index.h"
+#include "bitmap_index.h"
+#include "test_util.h"
+#include <algorithm>
+#include <random>
+
+using namespace std;
+
+static const char* const STATUSES[] = { " ", "", "" };
+static const char* const MANAGERS[] = { " ..", " ..", " .." };
+
+//           update
+int main() {
+    Repository<Contract> contracts("contract_update_test.dat");
+    auto table = make_shared<ContractTable>();
+    contracts.attachIndex(ContractTable::INDEX_NAME, table);
+    contracts.attachIndex("byAmount", makeSortedView<Contract>(Contract::AMOUNT));
+    contracts.attachIndex("byStatusAmount", makePartitionedView<Contract>(Contract::STATUS, Contract::AMOUNT));
+    contracts.attachIndex("byManager", makeHashIndex<Contract>(Contract::MANAGER));
+    auto statusBitmap = makeBitmapIndex<Contract>(Contract::STATUS);
+    contracts.attachIndex("statusBitmap", statusBitmap);
+
+    mt19937 rng(3);
+    const int count = 2000;
+    for (int id = 1; id <= count; ++id) {
+        contracts.emplace(id, 1, 1, Date(1, 1, 2024), 30, Money::fromUnits(rng() % 100000),
+            "", STATUSES[rng() % 3], MANAGERS[rng() % 3]);
+    }
+
+    for (int round = 0; round < 20; ++round) {
+        for (int i = 0; i < 200; ++i) {
+            int id = static_cast<int>(rng() % (count + 10)) + 1;
+            Money amount = Money::fromUnits(rng() % 100000);
+            string status = STATUSES[rng() % 3];
+            string manager = MANAGERS[rng() % 3];
+            bool updated = contracts.update(id, [&](Contract& contract) {
+                contract.setAmount(amount);
+                contract.setStatus(status);
+                contract.setManager(manager);
+                });
+            CHECK(updated == (id <= count));
+        }
+
+        Money lo = Money::fromUnits(rng() % 50000);
+        Money hi = lo + Money::fromUnits(rng() % 50000);
+        Money sum;
+        size_t inRange = 0;
+        vector<int> rangeIds;
+        size_t statusCount[3] = {};
+        size_t managerCount[3] = {};
+        //  ;   -  ID
+        int bestId = 0;
+        Money best = Money::min();
+        for (const Contract& contract : contracts.view()) {
+            sum += contract.getAmount();
+            if (contract.getAmount() > best || (contract.getAmount() == best && contract.getId() < bestId)) {
+                best = contract.getAmount();
+                bestId = contract.getId();
+            }
+            if (contract.getAmount() >= lo && contract.getAmount() <= hi) {
+                inRange++;
+                rangeIds.push_back(contract.getId());
+            }
+            for (int k = 0; k < 3; ++k) {
+                statusCount[k] += contract.getStatus() == STATUSES[k] ? 1 : 0;
+                managerCount[k] += contract.getManager() == MANAGERS[k] ? 1 : 0;
+            }
+        }
+        sort(rangeIds.begin(), rangeIds.end());
+
+        CHECK(table->size() == contracts.size());
+        CHECK(table->sumAmount() == sum);
+        CHECK(contracts.countRange("byAmount", lo, hi) == inRange);
+        vector<int> viewIds;
+        for (const Contract* contract : contracts.range("byAmount", lo, hi)) {
+            viewIds.push_back(contract->getId());
+        }
+        sort(viewIds.begin(), viewIds.end());
+        CHECK(viewIds == rangeIds);
+        CHECK(table->maxAmountId() == bestId);
+        for (int k = 0; k < 3; ++k) {
+            CHECK(table->countStatus(STATUSES[k]) == statusCount[k]);
+            CHECK(statusBitmap->bitmap(STATUSES[k]).cardinality() == statusCount[k]);
+            CHECK(contracts.ordered("byStatusAmount", STATUSES[k]).size() == statusCount[k]);
+            CHECK(contracts.idsByKey("byManager", string(MANAGERS[k])).size() == managerCount[k]);
+        }
+    }
+
+    //   fn    ,  
+    Money before = table->sumAmount();
+    Money amount = contracts.find(1)->getAmount();
+    CHECK_THROWS(contracts.update(1, [](Contract& contract) {
+        contract.setAmount(Money::fromUnits(1));
+        throw runtime_error("");
+        }), runtime_error);
+    CHECK(contracts.find(1)->getAmount() == amount);
+    CHECK(table->sumAmount() == before);
+
+    // ID     
+    CHECK_THROWS(contracts.update(2, [](Contract& contract) {
+        contract.setId(count + 100);
+        }), runtime_error);
+    CHECK(contracts.find(2) && !contracts.find(count + 100));
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,110 @@
+#include "contracts.h"
+#include "test_util.h"
+
+using namespace std;
+
+static_assert(Date(1, 1, 1970).toDayNumber() == 0, "   01.01.1970");
+static_assert(Date(31, 12, 1969).toDayNumber() == -1, "  1970 ");
+static_assert(Date(1, 3, 2000).toDayNumber() - Date(28, 2, 2000).toDayNumber() == 2, "2000 - ");
+
+static bool parses(string_view text, int day, int month, int year) {
+    Date date;
+    if (!Date::parse(text, date)) return false;
+    Date::Civil c = date.toCivil();
+    return c.day == day && c.month == month && c.year == year;
+}
+
+static bool rejected(string_view text) {
+    Date date = Date::fromDayNumber(12345);
+    //     
+    return !Date::parse(text, date) && date.toDayNumber() == 12345;
+}
+
+//   ".."       ,   ,
+//     
+int main() {
+    // 29      ( 4,   100,   400)
+    CHECK(parses("29.02.2024", 29, 2, 2024));
+    CHECK(parses("29.02.2000", 29, 2, 2000));
+    CHECK(parses("29.02.0400", 29, 2, 400));
+    CHECK(rejected("29.02.2023"));
+    CHECK(rejected("29.02.1900"));
+    CHECK(rejected("29.02.2100"));
+    CHECK(rejected("30.02.2024"));
+    CHECK(parses("28.02.2023", 28, 2, 2023));
+
+    //  
+    CHECK(rejected("31.04.2024"));
+    CHECK(rejected("31.06.2024"));
+    CHECK(rejected("31.09.2024"));
+    CHECK(rejected("31.11.2024"));
+    CHECK(parses("31.07.2024", 31, 7, 2024));
+    CHECK(parses("31.08.2024", 31, 8, 2024));
+    CHECK(parses("31.12.2024", 31, 12, 2024));
+    CHECK(parses("30.04.2024", 30, 4, 2024));
+    CHECK(rejected("00.01.2024"));
+    CHECK(rejected("01.00.2024"));
+    CHECK(rejected("01.13.2024"));
+    CHECK(rejected("32.01.2024"));
+    CHECK(parses("01.01.0000", 1, 1, 0));
+    CHECK(parses("31.12.9999", 31, 12, 9999));
+
+    //     :   '0'  '9' , , , 
+    //   CP1251  127
+    for (const char* text : { "0/.01.2024", "0:.01.2024", "01./1.2024", "01.01.202:", "1a.01.2024",
+        "01.01.20 4", " 1.01.2024", "+1.01.2024", "-1.01.2024", "01.01.-024", "01.01.\xC0\xC1\xC2\xC3", "\xB0" "1.01.2024" }) {
+        CHECK(rejected(text));
+    }
+    CHECK(rejected(string_view("01.01.20\0" "4", 10)));
+
+    //   
+    CHECK(rejected("01-01-2024"));
+    CHECK(rejected("01,01.2024"));
+    CHECK(rejected("1.01.2024"));
+    CHECK(rejected("01.1.2024"));
+    CHECK(rejected("01.01.24"));
+    CHECK(rejected("01.01.20245"));
+    CHECK(rejected(" 01.01.2024"));
+    CHECK(rejected(""));
+
+    //     daysInMonth,     
+    const int LENGTHS[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    for (int m = 1; m <= 12; ++m) {
+        CHECK(Date::daysInMonth(m, 2023) == LENGTHS[m - 1]);
+        CHECK(Date::daysInMonth(m, 2024) == LENGTHS[m - 1] + (m == 2 ? 1 : 0));
+    }
+
+    //     01.01.1600  31.12.2400:     ,
+    // toCivil    ,    - 
+    int dayNumber = Date(1, 1, 1600).toDayNumber();
+    int day = 1, month = 1, year = 1600;
+    while (year <= 2400) {
+        Date date(day, month, year);
+        CHECK(date.toDayNumber() == dayNumber);
+        Date::Civil c = Date::fromDayNumber(dayNumber).toCivil();
+        CHECK(c.day == day && c.month == month && c.year == year);
+        Date parsed;
+        CHECK(Date::parse(date.toString(), parsed) && parsed == date);
+
+        dayNumber++;
+        if (++day > Date::daysInMonth(month, year)) {
+            day = 1;
+            if (++month > 12) {
+                month = 1;
+                year++;
+            }
+        }
+    }
+    CHECK(Date(1, 1, 2401).toDayNumber() == dayNumber);
+    // 400    -  146097 
+    CHECK(Date(1, 1, 2000) - Date(1, 1, 1600) == 146097);
+
+    //       1970,      
+    for (int number = -1000000; number <= 1000000; number += 997) {
+        Date::Civil c = Date::fromDayNumber(number).toCivil();
+        CHECK(c.month >= 1 && c.month <= 12 && c.day >= 1 && c.day <= Date::daysInMonth(c.month, c.year));
+        CHECK(Date(c.day, c.month, c.year).toDayNumber() == number);
+        CHECK(Date::fromDayNumber(number).addDays(1).toCivil().day == (c.day == Date::daysInMonth(c.month, c.year) ? 1 : c.day + 1));
+    }
+    return 0;
+}
\ No newline at end of file
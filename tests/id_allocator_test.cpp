@@ -0,0 +1,124 @@
+#include "contracts.h"
+#include "test_util.h"
+#include <memory>
+#include <random>
+#include <set>
+
+using namespace std;
+
+static const string PATH = "id_allocator_test.dat";
+
+static mt19937 rng(20);
+
+enum class Mode { Text, Binary, Journal, JournalCompacting };
+
+static unique_ptr<Repository<Contract>> reopen(Mode mode) {
+    auto contracts = make_unique<Repository<Contract>>(PATH);
+    if (mode == Mode::Journal) contracts->enableJournal(1000000);
+    if (mode == Mode::JournalCompacting) contracts->enableJournal(1);
+    contracts->loadFromFile();
+    if (mode == Mode::Binary) contracts->setStorageFormat(Repository<Contract>::StorageFormat::Binary);
+    return contracts;
+}
+
+static void addContract(Repository<Contract>& contracts, int id) {
+    contracts.emplace(id, 1, 1, Date(1, 1, 2024), 10, Money::fromUnits(id), "", "", "");
+}
+
+static set<int> idsOf(const Repository<Contract>& contracts) {
+    set<int> ids;
+    contracts.forEach([&ids](const Contract& contract) {
+        ids.insert(contract.getId());
+        });
+    return ids;
+}
+
+// :    allocateId  reserveIds  ID 
+//      -   , 
+//   ,        ID 
+//   ID     
+static void testMonotonic(Mode mode) {
+    remove(PATH.c_str());
+    remove((PATH + ".log").c_str());
+    auto contracts = reopen(mode);
+    set<int> live;
+    int highest = 0;
+    for (int step = 0; step < 400; ++step) {
+        switch (rng() % 6) {
+        case 0: {
+            int id = contracts->allocateId();
+            CHECK(id > highest);
+            highest = id;
+            if (rng() % 2) {
+                addContract(*contracts, id);
+                live.insert(id);
+            }
+            break;
+        }
+        case 1: {
+            size_t count = 1 + rng() % 5;
+            int first = contracts->reserveIds(count);
+            CHECK(first > highest);
+            highest = first + static_cast<int>(count) - 1;
+            for (int id = first; id <= highest; ++id) {
+                if (rng() % 2) {
+                    addContract(*contracts, id);
+                    live.insert(id);
+                }
+            }
+            break;
+        }
+        case 2: {
+            //     ID  
+            int id = highest + 1 + static_cast<int>(rng() % 3);
+            addContract(*contracts, id);
+            live.insert(id);
+            highest = id;
+            break;
+        }
+        case 3:
+            if (!live.empty()) {
+                //      ID -    ID   
+                int id = rng() % 2 ? *live.rbegin() : *next(live.begin(), rng() % live.size());
+                CHECK(contracts->remove(id));
+                live.erase(id);
+            }
+            break;
+        case 4:
+            contracts->saveToFile();
+            break;
+        default:
+            contracts->saveToFile();
+            contracts = reopen(mode);
+            CHECK(idsOf(*contracts) == live);
+            break;
+        }
+    }
+    contracts->saveToFile();
+    contracts = reopen(mode);
+    CHECK(idsOf(*contracts) == live);
+    CHECK(contracts->allocateId() > highest);
+
+    //      ID,     
+    contracts = reopen(mode);
+    contracts->setIdReuse(true);
+    set<int> reused;
+    for (int i = 0; i < 50; ++i) {
+        int id = contracts->allocateId();
+        CHECK(id > 0 && live.count(id) == 0 && reused.insert(id).second);
+        addContract(*contracts, id);
+        live.insert(id);
+    }
+    CHECK(contracts->reserveIds(3) > highest);
+
+    remove(PATH.c_str());
+    remove((PATH + ".log").c_str());
+}
+
+int main() {
+    testMonotonic(Mode::Text);
+    testMonotonic(Mode::Binary);
+    testMonotonic(Mode::Journal);
+    testMonotonic(Mode::JournalCompacting);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,72 @@
+#include "contracts.h"
+#include "test_util.h"
+#include <climits>
+#include <random>
+#include <unordered_map>
+
+using namespace std;
+
+//  ,      unordered_map
+static void testAgainstReference() {
+    IdIndex index;
+    unordered_map<int, size_t> reference;
+    mt19937 rng(1);
+    for (size_t i = 0; i < 200000; ++i) {
+        int id = static_cast<int>(rng() % 5000) - 1000;
+        switch (rng() % 3) {
+        case 0:
+            index.insert(id, i);
+            reference[id] = i;
+            break;
+        case 1:
+            CHECK(index.erase(id) == (reference.erase(id) == 1));
+            break;
+        default: {
+            auto it = reference.find(id);
+            size_t slot = index.find(id);
+            CHECK((slot == IdIndex::npos) == (it == reference.end()));
+            CHECK(it == reference.end() || slot == it->second);
+        }
+        }
+    }
+    CHECK(index.size() == reference.size());
+}
+
+static void testRejectsEmptyMarker() {
+    IdIndex index;
+    index.insert(1, 0);
+    CHECK(index.find(INT_MIN) == IdIndex::npos);
+    CHECK(!index.erase(INT_MIN));
+    CHECK_THROWS(index.insert(INT_MIN, 1), runtime_error);
+    CHECK(index.size() == 1);
+
+    Repository<Client> clients("id_index_test_clients.dat");
+    CHECK_THROWS(clients.emplace(INT_MIN, "a", "b", "c", "d", "e"), runtime_error);
+    CHECK(clients.size() == 0);
+    CHECK(!clients.find(INT_MIN));
+}
+
+static void testRepositoryFindRemove() {
+    Repository<Client> clients("id_index_test_clients.dat");
+    for (int id = 1; id <= 1000; ++id) {
+        clients.emplace(id, " " + to_string(id), "b", "c", "d", "e");
+    }
+    for (int id = 2; id <= 1000; id += 2) {
+        CHECK(clients.remove(id));
+    }
+    CHECK(!clients.remove(2));
+    CHECK(clients.size() == 500);
+    CHECK(!clients.find(500));
+    CHECK(clients.find(501) && clients.find(501)->getCompanyName() == " 501");
+    //    ID  
+    clients.emplace(501, "", "b", "c", "d", "e");
+    CHECK(clients.size() == 500);
+    CHECK(clients.find(501)->getCompanyName() == "");
+}
+
+int main() {
+    testAgainstReference();
+    testRejectsEmptyMarker();
+    testRepositoryFindRemove();
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,37 @@
+#include "contracts.h"
+#include "test_util.h"
+
+using namespace std;
+
+int main() {
+    InternTable& table = InternTable::instance();
+
+    //          
+    InternedString first(" ");
+    InternedString second(string(" "));
+    CHECK(first == second);
+    CHECK(first.code() == second.code());
+    CHECK(InternedString() == InternedString(""));
+    CHECK(InternedString().code() == 0);
+
+    Contract contract(1, 1, 1, Date(1, 1, 2024), 30, Money::fromUnits(100), "", " ", " ..");
+    CHECK(contract.hasStatus(first));
+
+    //   -        
+    size_t before = table.size();
+    Repository<Contract> contracts("intern_table_test.dat");
+    for (int id = 1; id <= 1000; ++id) {
+        contracts.emplace(id, 1, 1, Date(1, 1, 2024), 30, Money::fromUnits(id), "", " ",
+            " " + to_string(id));
+    }
+    for (int id = 1; id <= 1000; ++id) {
+        contracts.update(id, [id](Contract& c) { c.setManager("  " + to_string(id)); });
+    }
+    Contract parsed;
+    CHECK(parsed.parseRecord("5 1 1 1 1 2024 30 100.00|| | "));
+    CHECK(parsed.getManager() == " ");
+    CHECK(table.size() == before);
+    CHECK(table.find(" 1") == nullptr);
+    CHECK(contracts.find(7)->getManager() == "  7");
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,106 @@
+#include "interval_index.h"
+#include "test_util.h"
+#include <algorithm>
+#include <fstream>
+#include <random>
+
+using namespace std;
+
+static mt19937 rng(7);
+
+static Date randomDate() {
+    return Date(rng() % 28 + 1, rng() % 12 + 1, 2015 + rng() % 10);
+}
+
+static vector<int> sorted(vector<int> ids) {
+    sort(ids.begin(), ids.end());
+    return ids;
+}
+
+// ;    ,     
+static int randomDuration() {
+    return rng() % 10 == 0 ? -static_cast<int>(rng() % 60) : 1 + static_cast<int>(rng() % 400);
+}
+
+static bool hasPeriod(const Contract& c) {
+    return c.getDuration() > 0;
+}
+
+//          ,
+//   
+int main() {
+    Repository<Contract> contracts("interval_index_test.dat");
+    auto intervals = make_shared<ContractIntervalIndex>();
+    contracts.attachIndex(ContractIntervalIndex::INDEX_NAME, intervals);
+    for (int i = 0; i < 30000; ++i) {
+        int id = static_cast<int>(rng() % 3000) + 1;
+        if (rng() % 4 == 0) {
+            contracts.remove(id);
+        }
+        else {
+            contracts.emplace(id, 1, 1, randomDate(), randomDuration(), Money(), "", " ", "");
+        }
+    }
+    CHECK(intervals->size() == contracts.count(hasPeriod));
+
+    int firstDay = Date(1, 1, 2015).toDayNumber();
+    for (int q = 0; q < 200; ++q) {
+        int from = firstDay + static_cast<int>(rng() % 4000);
+        int to = from + 1 + static_cast<int>(rng() % 100);
+        vector<int> overlapping, active, ending;
+        for (const Contract& c : contracts.filtered(hasPeriod)) {
+            int start = c.getStartDate().toDayNumber();
+            int end = start + c.getDuration();
+            if (start < to && end > from) overlapping.push_back(c.getId());
+            if (start <= from && end > from) active.push_back(c.getId());
+            if (end - 1 >= from && end - 1 <= to) ending.push_back(c.getId());
+        }
+        CHECK(sorted(intervals->overlapping(from, to)) == sorted(overlapping));
+        CHECK(intervals->countOverlapping(from, to) == overlapping.size());
+        CHECK(sorted(intervals->activeOn(from)) == sorted(active));
+        CHECK(sorted(intervals->endingBetween(from, to)) == sorted(ending));
+    }
+
+    vector<int> ids;
+    for (const Contract& c : contracts.view()) {
+        if (ids.size() == 300) break;
+        ids.push_back(c.getId());
+    }
+    size_t expectedPairs = 0;
+    for (size_t i = 0; i < ids.size(); ++i) {
+        for (size_t j = i + 1; j < ids.size(); ++j) {
+            auto a = contracts.find(ids[i]);
+            auto b = contracts.find(ids[j]);
+            if (!hasPeriod(*a) || !hasPeriod(*b)) continue;
+            int startA = a->getStartDate().toDayNumber();
+            int startB = b->getStartDate().toDayNumber();
+            if (startA < startB + b->getDuration() && startB < startA + a->getDuration()) expectedPairs++;
+        }
+    }
+    CHECK(intervals->overlappingPairs(ids).size() == expectedPairs);
+
+    //      ,   
+    const string path = "interval_index_test.txt";
+    {
+        ofstream file(path, ios::binary);
+        file << "1 1 1 10 3 2024 -30 1000|| |\n";
+        file << "2 1 1 10 3 2024 0 1000|| |\n";
+        file << "3 1 1 10 3 2024 5 1000|| |\n";
+    }
+    Repository<Contract> loaded(path);
+    auto loadedIntervals = make_shared<ContractIntervalIndex>();
+    loaded.attachIndex(ContractIntervalIndex::INDEX_NAME, loadedIntervals);
+    loaded.loadFromFile();
+    remove(path.c_str());
+    CHECK(loaded.size() == 3);
+    CHECK(loadedIntervals->size() == 1);
+    int day = Date(10, 3, 2024).toDayNumber();
+    for (int from = day - 60; from <= day + 10; from += 7) {
+        CHECK(loadedIntervals->countOverlapping(from, from + 30) == loadedIntervals->overlapping(from, from + 30).size());
+        CHECK(loadedIntervals->countOverlapping(from, from + 30) <= 1);
+    }
+    CHECK(loadedIntervals->overlapping(day - 60, day + 60) == vector<int>{ 3 });
+    CHECK(loadedIntervals->endingBetween(day - 60, day + 60) == vector<int>{ 3 });
+    CHECK(loadedIntervals->overlappingPairs({ 1, 2, 3 }).empty());
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,156 @@
+#include "contracts.h"
+#include "test_util.h"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+using namespace std;
+
+static const string PATH = "journal_test.txt";
+static const string LOG = PATH + ".log";
+static const string EXPORT = "journal_test_export.txt";
+
+static string readAll(const string& path) {
+    ifstream file(path, ios::binary);
+    stringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+static void append(const string& path, const string& text) {
+    ofstream file(path, ios::binary | ios::app);
+    file << text;
+}
+
+//         (  #nextId)
+static vector<string> recordsOf(const Repository<Contract>& contracts) {
+    contracts.exportText(EXPORT);
+    stringstream content(readAll(EXPORT));
+    vector<string> lines;
+    string line;
+    while (getline(content, line)) {
+        if (line[0] != '#') lines.push_back(line);
+    }
+    sort(lines.begin(), lines.end());
+    return lines;
+}
+
+static void load(Repository<Contract>& contracts) {
+    contracts.enableJournal();
+    contracts.loadFromFile();
+}
+
+static void addContract(Repository<Contract>& contracts, int id, int amount) {
+    contracts.emplace(id, 1 + id % 7, 1 + id % 5, Date(1, 1 + id % 12, 2024), 10 + id,
+        Money::fromUnits(amount), "", " ", " ..");
+}
+
+//  :         ,
+//           ,
+//  #nextId  ,    
+int main() {
+    remove(PATH.c_str());
+    remove(LOG.c_str());
+
+    Repository<Contract> contracts(PATH);
+    contracts.enableJournal();
+    for (int id = 1; id <= 5; ++id) {
+        addContract(contracts, id, id * 100);
+    }
+    contracts.saveToFile();
+    CHECK(!readAll(LOG).empty());
+
+    // ,     : ,   
+    contracts.compactJournal();
+    CHECK(readAll(LOG).empty());
+    addContract(contracts, 6, 600);
+    addContract(contracts, 2, 250);
+    contracts.update(3, [](Contract& contract) { contract.setStatus(""); });
+    contracts.remove(4);
+    contracts.saveToFile();
+    {
+        Repository<Contract> reloaded(PATH);
+        load(reloaded);
+        CHECK(reloaded.size() == 5);
+        CHECK(!reloaded.find(4));
+        CHECK(reloaded.find(2)->getAmount() == Money::fromUnits(250));
+        CHECK(reloaded.find(3)->getStatus() == "");
+        CHECK(recordsOf(reloaded) == recordsOf(contracts));
+    }
+
+    //   :     (   ,
+    //       )
+    vector<string> before = recordsOf(contracts);
+    for (const string& tail : { string("+ 7 1 1 1 1 2024 10 700|"), string("- 5"), string("#nextId 9") }) {
+        append(LOG, tail);
+        {
+            Repository<Contract> reloaded(PATH);
+            load(reloaded);
+            CHECK(recordsOf(reloaded) == before);
+            //           
+            CHECK(readAll(LOG).empty());
+            addContract(reloaded, 8, 800);
+            reloaded.saveToFile();
+        }
+        Repository<Contract> next(PATH);
+        load(next);
+        CHECK(next.find(8) && next.size() == before.size() + 1);
+        next.remove(8);
+        next.saveToFile();
+    }
+
+    //  #nextId: ID, ,     ,  ID ,
+    //     ,     
+    int highest = 0;
+    {
+        Repository<Contract> current(PATH);
+        load(current);
+        int used = current.allocateId();
+        addContract(current, used, 1);
+        int removed = current.allocateId();
+        addContract(current, removed, 2);
+        current.remove(removed);
+        highest = current.reserveIds(3) + 2;
+        current.saveToFile();
+        CHECK(readAll(LOG).find("#nextId " + to_string(highest + 1)) != string::npos);
+    }
+    {
+        Repository<Contract> reloaded(PATH);
+        load(reloaded);
+        CHECK(reloaded.allocateId() == highest + 1);
+    }
+
+    //   :  ,       
+    {
+        Repository<Contract> current(PATH);
+        current.enableJournal(1);
+        current.loadFromFile();
+        //        :    
+        bool compacted = false;
+        for (int amount = 1; amount <= 20; ++amount) {
+            addContract(current, 100, amount);
+            current.saveToFile();
+            compacted = compacted || readAll(LOG).empty();
+        }
+        CHECK(compacted);
+        CHECK(current.find(100)->getAmount() == Money::fromUnits(20));
+        addContract(current, 101, 1);
+        current.saveToFile();
+        current.remove(100);
+        current.saveToFile();
+        before = recordsOf(current);
+        current.compactJournal();
+        CHECK(readAll(LOG).empty());
+
+        Repository<Contract> reloaded(PATH);
+        load(reloaded);
+        CHECK(recordsOf(reloaded) == before);
+        CHECK(!reloaded.find(100));
+        CHECK(reloaded.allocateId() > highest);
+    }
+
+    remove(PATH.c_str());
+    remove(LOG.c_str());
+    remove(EXPORT.c_str());
+    return 0;
+}
\ No newline at end of file
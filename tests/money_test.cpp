@@ -0,0 +1,107 @@
+#include "money.h"
+#include "field_schema.h"
+#include "test_util.h"
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+using namespace std;
+
+static bool parsesTo(string_view text, int64_t minor) {
+    Money value = Money::fromMinor(-777);
+    return Money::parse(text, value) && value.minorUnits() == minor;
+}
+
+static bool rejected(string_view text) {
+    Money value = Money::fromMinor(-777);
+    //     
+    return !Money::parse(text, value) && value.minorUnits() == -777;
+}
+
+//  double    2,   
+static Money loadLegacy(double amount) {
+    char record[sizeof(double)];
+    memcpy(record, &amount, sizeof(amount));
+    BinaryRecordReader reader(record, sizeof(record), nullptr, 0, 2);
+    Money value;
+    FieldCodec<Money>::load(reader, value);
+    return value;
+}
+
+//     :    ,
+//    ,    
+int main() {
+    CHECK(parsesTo("250000", 25000000));
+    CHECK(parsesTo("1500.5", 150050));
+    CHECK(parsesTo("99,95", 9995));
+    CHECK(parsesTo(" -10.00\t", -1000));
+    CHECK(parsesTo("+7", 700));
+    CHECK(parsesTo(".5", 50));
+    CHECK(parsesTo("5.", 500));
+    CHECK(parsesTo("-0", 0));
+
+    //      ,  
+    CHECK(parsesTo("1.004", 100));
+    CHECK(parsesTo("1.005", 101));
+    CHECK(parsesTo("1.0049999", 100));
+    CHECK(parsesTo("0.999", 100));
+    CHECK(parsesTo("-1.005", -101));
+    CHECK(parsesTo("-0.994", -99));
+    CHECK(parsesTo("9.995", 1000));
+
+    //  ,  double    
+    CHECK(parsesTo("1.23457e+06", 123457000));
+    CHECK(parsesTo("1E2", 10000));
+    CHECK(parsesTo("-2.5e-1", -25));
+    CHECK(parsesTo("+1e0", 100));
+    CHECK(parsesTo("1.2345e2", 12345));
+    CHECK(rejected("1e17"));
+    CHECK(rejected("-1e17"));
+    CHECK(rejected("1e400"));
+    CHECK(rejected("1e"));
+    CHECK(rejected("e5"));
+    CHECK(rejected("1e5x"));
+
+    // :   UNITS_LIMIT * 10 + 9      int64
+    int64_t largest = Money::UNITS_LIMIT * 10 + 9;
+    CHECK(parsesTo(to_string(largest) + ".99", largest * Money::SCALE + 99));
+    CHECK(parsesTo("-" + to_string(largest) + ".99", -(largest * Money::SCALE + 99)));
+    CHECK(rejected(to_string(largest + 1)));
+    CHECK(rejected("9223372036854775807"));
+    CHECK(rejected("-9223372036854775808"));
+    CHECK(rejected("99999999999999999999999999"));
+
+    CHECK(rejected(""));
+    CHECK(rejected("   "));
+    CHECK(rejected("-"));
+    CHECK(rejected("."));
+    CHECK(rejected("1.2.3"));
+    CHECK(rejected("12a"));
+    CHECK(rejected("1 000"));
+    CHECK(rejected("--1"));
+    CHECK(rejected("nan"));
+    CHECK(rejected("inf"));
+
+    Money value;
+    CHECK(Money::fromDouble(1234.56, value) && value.minorUnits() == 123456);
+    CHECK(Money::fromDouble(-0.125, value) && value.minorUnits() == -13);
+    CHECK(Money::fromDouble(9e16, value) && value.minorUnits() == 9000000000000000000LL);
+    value = Money::fromMinor(5);
+    CHECK(!Money::fromDouble(numeric_limits<double>::quiet_NaN(), value));
+    CHECK(!Money::fromDouble(numeric_limits<double>::infinity(), value));
+    CHECK(!Money::fromDouble(-numeric_limits<double>::infinity(), value));
+    CHECK(!Money::fromDouble(1e17, value));
+    CHECK(!Money::fromDouble(-9.3e16, value));
+    CHECK(value.minorUnits() == 5);
+
+    //        
+    CHECK(loadLegacy(1500.5) == Money::fromMinor(150050));
+    CHECK_THROWS(loadLegacy(numeric_limits<double>::quiet_NaN()), runtime_error);
+    CHECK_THROWS(loadLegacy(1e300), runtime_error);
+
+    //     
+    for (int64_t minor : { int64_t(0), int64_t(5), int64_t(-5), int64_t(100), int64_t(-123456), largest * Money::SCALE + 99 }) {
+        CHECK(parsesTo(Money::fromMinor(minor).toString(), minor));
+    }
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,126 @@
+#include "contracts.h"
+#include "parallel_sort.h"
+#include "test_util.h"
+#include <algorithm>
+#include <random>
+#include <limits>
+
+using namespace std;
+
+static mt19937 rng(25);
+
+static const char* const STATUSES[] = { " ", "", "", "" };
+static const char* const MANAGERS[] = { "", "", "", "", "" };
+
+//    PARALLEL_SORT_THRESHOLD:       
+static const size_t SIZES[] = { PARALLEL_SORT_THRESHOLD + 1, PARALLEL_SORT_THRESHOLD * 3 + 17, PARALLEL_SORT_THRESHOLD * 5 - 3 };
+
+// :    ,   ,    
+struct Item {
+    int64_t key;
+    size_t position;
+};
+
+static bool sameOrder(const vector<Item>& a, const vector<Item>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].key != b[i].key || a[i].position != b[i].position) return false;
+    }
+    return true;
+}
+
+//     ,     int64
+static vector<Item> makeItems(size_t n, int64_t distinct) {
+    vector<Item> items(n);
+    for (size_t i = 0; i < n; ++i) {
+        int64_t key = (static_cast<int64_t>(rng() % distinct) - distinct / 2) * (rng() % 2 ? 1 : 1000003);
+        if (rng() % 50 == 0) {
+            key = rng() % 2 ? numeric_limits<int64_t>::min() : numeric_limits<int64_t>::max();
+        }
+        items[i] = Item{ key, i };
+    }
+    return items;
+}
+
+//  parallelStableSort, radixSort  sortRecords   std::stable_sort
+//    ,        .
+// ctest    KURSACH_THREADS=4,       
+int main() {
+    CHECK(sortChunkCount(SIZES[0]) > 1);
+    auto byKey = [](const Item& a, const Item& b) { return a.key < b.key; };
+
+    for (size_t n : SIZES) {
+        for (int64_t distinct : { 2, 1000, 1 << 30 }) {
+            vector<Item> items = makeItems(n, distinct);
+            vector<Item> expected = items;
+            stable_sort(expected.begin(), expected.end(), byKey);
+
+            vector<Item> merged = items;
+            parallelStableSort(merged, byKey);
+            CHECK(sameOrder(merged, expected));
+
+            //  int64  Money:      
+            vector<Item> radix = items;
+            radixSort(radix, 1, [](const Item& item, size_t) {
+                return RadixKey<Money>::encode(Money::fromMinor(item.key));
+                });
+            CHECK(sameOrder(radix, expected));
+
+            //  :  -   ( ),  -  int
+            auto twoKeys = [](const Item& a, const Item& b) {
+                bool aNegative = a.key < 0;
+                bool bNegative = b.key < 0;
+                if (aNegative != bNegative) return aNegative > bNegative;
+                return static_cast<int>(a.key % 1000) < static_cast<int>(b.key % 1000);
+            };
+            vector<Item> expectedTwo = items;
+            stable_sort(expectedTwo.begin(), expectedTwo.end(), twoKeys);
+            vector<Item> radixTwo = items;
+            radixSort(radixTwo, 2, [](const Item& item, size_t k) {
+                return k == 0 ? ~RadixKey<bool>::encode(item.key < 0) : RadixKey<int>::encode(static_cast<int>(item.key % 1000));
+                });
+            CHECK(sameOrder(radixTwo, expectedTwo));
+        }
+    }
+
+    //  :   ()     ()
+    Repository<Contract> contracts("parallel_sort_test.dat");
+    size_t count = PARALLEL_SORT_THRESHOLD * 2 + 101;
+    for (size_t i = 0; i < count; ++i) {
+        int id = static_cast<int>(i) + 1;
+        contracts.emplace(id, 1 + rng() % 50, 1 + rng() % 30, Date::fromDayNumber(static_cast<int>(rng() % 800) - 400),
+            static_cast<int>(rng() % 21) - 10, Money::fromMinor(static_cast<int64_t>(rng() % 2001) - 1000),
+            "", STATUSES[rng() % 4], MANAGERS[rng() % 5]);
+    }
+    vector<const Contract*> stored = contracts.findAll();
+
+    {
+        vector<const Contract*> expected = stored;
+        stable_sort(expected.begin(), expected.end(), [](const Contract* a, const Contract* b) {
+            if (a->getDuration() != b->getDuration()) return a->getDuration() > b->getDuration();
+            if (a->getAmount() != b->getAmount()) return a->getAmount() < b->getAmount();
+            return b->getStartDate() < a->getStartDate();
+            });
+        CHECK(contracts.sortBy(sortKey(Contract::DURATION, true), sortKey(Contract::AMOUNT),
+            sortKey(Contract::START_DATE, true)) == expected);
+    }
+    {
+        vector<const Contract*> expected = stored;
+        stable_sort(expected.begin(), expected.end(), [](const Contract* a, const Contract* b) {
+            if (a->getStatus() != b->getStatus()) return a->getStatus() > b->getStatus();
+            if (a->getAmount() != b->getAmount()) return a->getAmount() > b->getAmount();
+            return a->getManager() < b->getManager();
+            });
+        CHECK(contracts.sortBy(sortKey(Contract::STATUS, true), sortKey(Contract::AMOUNT, true),
+            sortKey(Contract::MANAGER)) == expected);
+    }
+    {
+        //      :   -  
+        vector<const Contract*> expected = stored;
+        stable_sort(expected.begin(), expected.end(), [](const Contract* a, const Contract* b) {
+            return a->getStatus() < b->getStatus();
+            });
+        CHECK(contracts.sortBy(sortKey(Contract::STATUS)) == expected);
+    }
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,156 @@
+#include "query.h"
+#include "sorted_view.h"
+#include "secondary_index.h"
+#include "trigram_index.h"
+#include "interval_index.h"
+#include "test_util.h"
+#include <algorithm>
+#include <random>
+
+using namespace std;
+
+static const char* const STATUSES[] = { " ", "", "", "" };
+static const char* const MANAGERS[] = { "", "", "", "", "" };
+
+//  ,  :      
+template<typename T, typename Getter>
+class CountingTrigramIndex : public TrigramIndex<T, Getter> {
+public:
+    mutable size_t searches = 0;
+
+    explicit CountingTrigramIndex(Getter getter) : TrigramIndex<T, Getter>(getter) {}
+
+    vector<int> match(const string& pattern) const override {
+        searches++;
+        return TrigramIndex<T, Getter>::match(pattern);
+    }
+};
+
+static vector<int> idsOf(const vector<const Contract*>& contracts) {
+    vector<int> ids;
+    for (const auto& contract : contracts) {
+        ids.push_back(contract->getId());
+    }
+    sort(ids.begin(), ids.end());
+    return ids;
+}
+
+template<typename Pred>
+static vector<int> scan(const Repository<Contract>& contracts, Pred pred) {
+    vector<int> ids;
+    for (const Contract& contract : contracts.view()) {
+        if (pred(contract)) {
+            ids.push_back(contract.getId());
+        }
+    }
+    sort(ids.begin(), ids.end());
+    return ids;
+}
+
+int main() {
+    const int count = 20000;
+    Repository<Contract> contracts("query_test.dat");
+    for (int id = 1; id <= count; ++id) {
+        contracts.emplace(id, 1 + id % 500, 1 + id % 300, Date::fromDayNumber(19000 + (id * 37) % 1500), 1 + id % 90,
+            Money::fromUnits((id * 7919LL) % 100000), "", STATUSES[id % 4], MANAGERS[(id / 3) % 5]);
+    }
+    auto intervals = make_shared<ContractIntervalIndex>();
+    auto managerText = make_shared<CountingTrigramIndex<Contract, decay_t<decltype(Contract::MANAGER)>>>(Contract::MANAGER);
+    contracts.attachIndex(ContractIntervalIndex::INDEX_NAME, intervals);
+    contracts.attachIndex("byAmount", makeSortedView<Contract>(Contract::AMOUNT));
+    contracts.attachIndex("byAmountDesc", makeSortedView<Contract>(Contract::AMOUNT, greater<>()));
+    contracts.attachIndex("managerText", managerText);
+    contracts.attachIndex("byClient", makeHashIndex<Contract>(Contract::CLIENT_ID));
+    contracts.attachIndex("statusBitmap", makeBitmapIndex<Contract>(Contract::STATUS));
+
+    //     
+    {
+        Query<Contract> query(contracts);
+        query.where(eq(Contract::STATUS, string("")))
+            .where(contains(Contract::MANAGER, ""))
+            .where(between(Contract::AMOUNT, Money::fromUnits(1000), Money::fromUnits(5000)));
+        CHECK(idsOf(query.run()) == scan(contracts, [](const Contract& c) {
+            return c.getStatus() == "" && c.getManager().find("") != string::npos &&
+                c.getAmount() >= Money::fromUnits(1000) && c.getAmount() <= Money::fromUnits(5000);
+            }));
+    }
+    {
+        Query<Contract> query(contracts);
+        query.where(anyOf(eq(Contract::CLIENT_ID, 3), eq(Contract::CLIENT_ID, 4),
+            allOf(eq(Contract::STATUS, string("")), between(Contract::AMOUNT, Money::fromUnits(0), Money::fromUnits(50)))));
+        CHECK(idsOf(query.run()) == scan(contracts, [](const Contract& c) {
+            return c.getClientId() == 3 || c.getClientId() == 4 || (c.getStatus() == "" && c.getAmount() <= Money::fromUnits(50));
+            }));
+    }
+    {
+        Query<Contract> found(contracts);
+        found.where(eq(Contract::ID, 42));
+        CHECK(idsOf(found.run()) == vector<int>{ 42 });
+        Query<Contract> missing(contracts);
+        missing.where(eq(Contract::ID, count + 5));
+        CHECK(missing.run().empty());
+    }
+    {
+        Query<Contract> query(contracts);
+        query.where(eq(Contract::STATUS, string(""))).orderBy(Contract::AMOUNT, true).offset(5).limit(10);
+        vector<const Contract*> expected;
+        for (const Contract& c : contracts.view()) {
+            if (c.getStatus() == "") expected.push_back(&c);
+        }
+        stable_sort(expected.begin(), expected.end(), [](const Contract* a, const Contract* b) {
+            return b->getAmount() < a->getAmount();
+            });
+        auto result = query.run();
+        CHECK(result.size() == 10);
+        for (size_t i = 0; i < result.size(); ++i) {
+            CHECK(result[i]->getAmount() == expected[i + 5]->getAmount());
+        }
+    }
+
+    //    :  -  ,  -  
+    mt19937 rng(11);
+    for (int i = 0; i < 300; ++i) {
+        int from = 18990 + static_cast<int>(rng() % 1700);
+        int to = from + static_cast<int>(rng() % 60);
+        CHECK(intervals->countOverlapping(from, to) == intervals->overlapping(from, to).size());
+    }
+    for (const char* pattern : { "", "", "", "", "xyz", "" }) {
+        CHECK(managerText->estimateMatches(pattern) >= managerText->match(pattern).size());
+    }
+
+    // explain()  run()    ,       run()
+    {
+        Query<Contract> query(contracts);
+        query.where(contains(Contract::MANAGER, ""));
+        managerText->searches = 0;
+        string plan = query.explain();
+        CHECK(plan.find("managerText") != string::npos);
+        CHECK(managerText->searches == 0);
+        auto result = query.run();
+        CHECK(managerText->searches == 1);
+        CHECK(idsOf(result) == scan(contracts, [](const Contract& c) { return c.getManager() == ""; }));
+        CHECK(query.explain() == plan);
+
+        //    
+        query.where(eq(Contract::CLIENT_ID, 7));
+        CHECK(query.explain() != plan);
+        CHECK(query.explain().find("byClient") != string::npos);
+    }
+
+    //   : ,    ,  
+    {
+        Repository<Contract> empty("query_test_empty.dat");
+        empty.attachIndex("byClient", makeHashIndex<Contract>(Contract::CLIENT_ID));
+        Query<Contract> query(empty);
+        query.where(eq(Contract::CLIENT_ID, 7)).where(eq(Contract::STATUS, string("")));
+        CHECK(query.run().empty());
+        for (int id = 1; id <= 100; ++id) {
+            empty.emplace(id, id % 10, 1, Date(1, 1, 2024), 10, Money::fromUnits(id), "", STATUSES[id % 4], "");
+        }
+        CHECK(idsOf(query.run()) == scan(empty, [](const Contract& c) {
+            return c.getClientId() == 7 && c.getStatus() == "";
+            }));
+        CHECK(query.explain().find("byClient") != string::npos);
+    }
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,139 @@
+#include "roaring_bitmap.h"
+#include "test_util.h"
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <set>
+
+using namespace std;
+
+static mt19937 rng(11);
+
+//  16 :  ,    
+static const uint32_t KEYS[] = { 0, 1, 7, 0xFFFF };
+//  : ,   ARRAY_MAX = 4096   , 
+static const size_t SIZES[] = { 0, 50, 4095, 4096, 4097, 4200, 30000 };
+
+static set<uint32_t> elements(const RoaringBitmap& bitmap) {
+    set<uint32_t> result;
+    uint32_t previous = 0;
+    bool first = true;
+    bitmap.forEach([&](uint32_t value) {
+        // forEach     
+        CHECK(first || value > previous);
+        first = false;
+        previous = value;
+        result.insert(value);
+        });
+    return result;
+}
+
+static void checkSame(const RoaringBitmap& bitmap, const set<uint32_t>& expected) {
+    CHECK(bitmap.cardinality() == expected.size());
+    CHECK(bitmap.empty() == expected.empty());
+    CHECK(elements(bitmap) == expected);
+    for (uint32_t value : expected) {
+        CHECK(bitmap.contains(value));
+    }
+    for (int i = 0; i < 200; ++i) {
+        uint32_t value = (KEYS[rng() % size(KEYS)] << 16) | (rng() & 0xFFFF);
+        CHECK(bitmap.contains(value) == (expected.count(value) > 0));
+    }
+}
+
+//  :        
+static void fill(RoaringBitmap& bitmap, set<uint32_t>& expected) {
+    for (uint32_t key : KEYS) {
+        if (rng() % 3 == 0) continue;
+        //    ,    
+        uint32_t span = rng() % 2 ? 0x10000 : 12000;
+        size_t count = min<size_t>(SIZES[rng() % size(SIZES)], span);
+        while (count > 0) {
+            uint32_t value = (key << 16) | (rng() % span);
+            if (expected.insert(value).second) {
+                bitmap.add(value);
+                count--;
+            }
+        }
+    }
+}
+
+//      std::set,     
+//       
+int main() {
+    //   ->   ->       
+    {
+        RoaringBitmap bitmap;
+        set<uint32_t> expected;
+        for (uint32_t low = 0; low < 4096; ++low) {
+            uint32_t value = (1u << 16) | (low * 7 % 0x10000);
+            bitmap.add(value);
+            expected.insert(value);
+        }
+        checkSame(bitmap, expected);
+        bitmap.add(*expected.begin()); //    
+        checkSame(bitmap, expected);
+        for (uint32_t low = 50000; low < 50010; ++low) {
+            bitmap.add((1u << 16) | low);
+            expected.insert((1u << 16) | low);
+            checkSame(bitmap, expected);
+        }
+        while (!expected.empty()) {
+            auto it = expected.begin();
+            advance(it, rng() % expected.size());
+            CHECK(bitmap.remove(*it));
+            CHECK(!bitmap.remove(*it));
+            expected.erase(it);
+            if (expected.size() % 500 == 0 || expected.size() < 4100) {
+                CHECK(bitmap.cardinality() == expected.size());
+            }
+        }
+        //       
+        checkSame(bitmap, expected);
+    }
+
+    for (int round = 0; round < 60; ++round) {
+        RoaringBitmap a, b;
+        set<uint32_t> sa, sb;
+        fill(a, sa);
+        fill(b, sb);
+        if (round % 10 == 0) {
+            b = a;
+            sb = sa;
+        }
+        checkSame(a, sa);
+        checkSame(b, sb);
+
+        set<uint32_t> both, either, onlyA, onlyB;
+        set_intersection(sa.begin(), sa.end(), sb.begin(), sb.end(), inserter(both, both.end()));
+        set_union(sa.begin(), sa.end(), sb.begin(), sb.end(), inserter(either, either.end()));
+        set_difference(sa.begin(), sa.end(), sb.begin(), sb.end(), inserter(onlyA, onlyA.end()));
+        set_difference(sb.begin(), sb.end(), sa.begin(), sa.end(), inserter(onlyB, onlyB.end()));
+
+        checkSame(a & b, both);
+        checkSame(b & a, both);
+        checkSame(a | b, either);
+        checkSame(b | a, either);
+        checkSame(a.andNot(b), onlyA);
+        checkSame(b.andNot(a), onlyB);
+        checkSame(a.andNot(a), set<uint32_t>());
+        checkSame(a & RoaringBitmap(), set<uint32_t>());
+        checkSame(a | RoaringBitmap(), sa);
+
+        //     :   
+        RoaringBitmap c = a & b;
+        set<uint32_t> sc = both;
+        for (int i = 0; i < 3000; ++i) {
+            uint32_t value = (KEYS[rng() % size(KEYS)] << 16) | (rng() % 12000);
+            if (rng() % 2) {
+                c.add(value);
+                sc.insert(value);
+            }
+            else {
+                CHECK(c.remove(value) == (sc.erase(value) > 0));
+            }
+        }
+        checkSame(c, sc);
+    }
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,78 @@
+#include "contracts.h"
+#include "test_util.h"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+using namespace std;
+
+static string readAll(const string& path) {
+    ifstream file(path, ios::binary);
+    stringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+//   RecordWriter    ,  
+//     
+int main() {
+    const string path = "save_roundtrip_test.txt";
+    {
+        Repository<Contract> contracts(path);
+        contracts.emplace(1, 2, 3, Date(5, 6, 2024), 90, Money::fromMinor(1234567), "", " ", " ..");
+        contracts.emplace(2, 4, 5, Date(31, 12, 2023), 1, Money::fromMinor(-5), "", "", "");
+        contracts.emplace(3, 7, 8, Date(1, 1, 2025), 365, Money::fromMinor(99999999999LL), " ", "", " ..");
+        contracts.remove(2);
+        contracts.saveToFile();
+    }
+    {
+        Repository<Contract> contracts(path);
+        contracts.loadFromFile();
+        CHECK(contracts.size() == 2);
+        CHECK(!contracts.find(2));
+        auto first = contracts.find(1);
+        CHECK(first && first->getClientId() == 2 && first->getObjectId() == 3);
+        CHECK(first->getStartDate().toDayNumber() == Date(5, 6, 2024).toDayNumber());
+        CHECK(first->getDuration() == 90 && first->getAmount() == Money::fromMinor(1234567));
+        CHECK(first->getWorkType() == "" && first->getStatus() == " " && first->getManager() == " ..");
+        auto third = contracts.find(3);
+        CHECK(third && third->getAmount() == Money::fromMinor(99999999999LL));
+        CHECK(third->getWorkType() == " ");
+    }
+
+    const string clientPath = "save_roundtrip_clients.txt";
+    {
+        Repository<Client> clients(clientPath);
+        clients.emplace(1, " ", " ..", "+7 900 000-00-00", "mail@example.ru", ". , . , 1");
+        clients.emplace(2, " ", "", "", "", "");
+        clients.saveToFile();
+    }
+    {
+        Repository<Client> clients(clientPath);
+        clients.loadFromFile();
+        CHECK(clients.size() == 2);
+        auto first = clients.find(1);
+        CHECK(first && first->getCompanyName() == " " && first->getAddress() == ". , . , 1");
+        auto second = clients.find(2);
+        CHECK(second && second->getCompanyName() == " " && second->getEmail().empty());
+    }
+
+    //     (   ):  
+    // ,     
+    string before = readAll(path);
+    filesystem::create_directory(path + ".tmp");
+    {
+        Repository<Contract> contracts(path);
+        contracts.loadFromFile();
+        contracts.emplace(10, 1, 1, Date(1, 1, 2024), 10, Money::fromUnits(1), "", " ", " ..");
+        CHECK_THROWS(contracts.exportText(path), runtime_error);
+    }
+    CHECK(readAll(path) == before);
+    filesystem::remove(path + ".tmp");
+
+    remove(path.c_str());
+    remove(clientPath.c_str());
+    remove((path + ".log").c_str());
+    remove((clientPath + ".log").c_str());
+    return 0;
+}
\ No newline at end of file
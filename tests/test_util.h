@@ -0,0 +1,29 @@
+#ifndef TEST_UTIL_H
+#define TEST_UTIL_H
+
+#include <cstdio>
+#include <cstdlib>
+
+// ,       NDEBUG:       
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            std::fprintf(stderr, "%s:%d:   : %s\n", __FILE__, __LINE__, #condition); \
+            std::exit(1); \
+        } \
+    } while (0)
+
+//    Error  
+#define CHECK_THROWS(expression, Error) \
+    do { \
+        bool thrown = false; \
+        try { \
+            expression; \
+        } \
+        catch (const Error&) { \
+            thrown = true; \
+        } \
+        CHECK(thrown && #expression); \
+    } while (0)
+
+#endif // TEST_UTIL_H
\ No newline at end of file
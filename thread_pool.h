@@ -0,0 +1,149 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <memory>
+#include <functional>
+#include <exception>
+#include <cstdlib>
+
+//         .
+// ,  parallelFor,     , 
+//            .
+class ThreadPool {
+private:
+    struct Batch {
+        std::function<void(size_t)> task;
+        size_t count = 0;
+        std::atomic<size_t> next{ 0 };
+        std::atomic<size_t> done{ 0 };
+        std::exception_ptr error;
+    };
+
+    std::vector<std::thread> workers;
+    std::deque<std::shared_ptr<Batch>> batches;
+    std::mutex mutex;
+    std::condition_variable workAvailable;
+    std::condition_variable batchFinished;
+    bool stopping = false;
+
+    bool runOne(Batch& batch) {
+        size_t i = batch.next++;
+        if (i >= batch.count) {
+            return false;
+        }
+        try {
+            batch.task(i);
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!batch.error) batch.error = std::current_exception();
+        }
+        if (++batch.done == batch.count) {
+            std::lock_guard<std::mutex> lock(mutex);
+            batchFinished.notify_all();
+        }
+        return true;
+    }
+
+    void workerLoop() {
+        while (true) {
+            std::shared_ptr<Batch> batch;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                workAvailable.wait(lock, [this] { return stopping || !batches.empty(); });
+                if (stopping) return;
+                batch = batches.front();
+                if (batch->next >= batch->count) {
+                    batches.pop_front();
+                    continue;
+                }
+            }
+            while (runOne(*batch)) {}
+        }
+    }
+
+public:
+    explicit ThreadPool(size_t threads) {
+        for (size_t i = 0; i < threads; ++i) {
+            workers.emplace_back([this] { workerLoop(); });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        workAvailable.notify_all();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    //     :      .
+    //   KURSACH_THREADS     -  
+    //      
+    static size_t defaultWorkerCount() {
+        if (const char* value = std::getenv("KURSACH_THREADS")) {
+            int threads = std::atoi(value);
+            if (threads > 0) return static_cast<size_t>(threads) - 1;
+        }
+        unsigned hardware = std::thread::hardware_concurrency();
+        return hardware > 1 ? hardware - 1 : 0;
+    }
+
+    static ThreadPool& instance() {
+        static ThreadPool pool(defaultWorkerCount());
+        return pool;
+    }
+
+    //  ,    ( )
+    size_t concurrency() const {
+        return workers.size() + 1;
+    }
+
+    //  task(0) ... task(count - 1)     
+    template<typename Task>
+    void parallelFor(size_t count, Task task) {
+        if (count == 0) return;
+        if (count == 1 || workers.empty()) {
+            for (size_t i = 0; i < count; ++i) {
+                task(i);
+            }
+            return;
+        }
+        auto batch = std::make_shared<Batch>();
+        batch->task = task;
+        batch->count = count;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            batches.push_back(batch);
+        }
+        workAvailable.notify_all();
+        while (runOne(*batch)) {}
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            batchFinished.wait(lock, [&batch] { return batch->done == batch->count; });
+            for (auto it = batches.begin(); it != batches.end(); ++it) {
+                if (*it == batch) {
+                    batches.erase(it);
+                    break;
+                }
+            }
+        }
+        if (batch->error) {
+            std::rethrow_exception(batch->error);
+        }
+    }
+};
+
+#endif // THREAD_POOL_H
\ No newline at end of file
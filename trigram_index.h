@@ -0,0 +1,172 @@
+#ifndef TRIGRAM_INDEX_H
+#define TRIGRAM_INDEX_H
+
+#include "contracts.h"
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <algorithm>
+#include <functional>
+#include <cstdint>
+#include <iterator>
+
+//         .
+//  -    ;   CP1251   ,
+//     ,  .  ,
+//       std::string::find.
+//    ID   (   )
+//        -   ,
+//    :     .
+template<typename T, typename Getter>
+class TrigramIndex : public TextIndex<T> {
+private:
+    Getter getter;
+    //  ID  ,    
+    std::unordered_map<uint32_t, std::vector<int>> postings;
+    const Repository<T>* repo = nullptr;
+
+    static std::string_view textOf(std::string_view text) { return text; }
+    static std::string_view textOf(const std::string& text) { return text; }
+
+    std::string_view textOf(const T& item) const {
+        return textOf(std::invoke(getter, item));
+    }
+
+    static uint32_t trigram(std::string_view text, size_t pos) {
+        return static_cast<uint32_t>(static_cast<unsigned char>(text[pos])) << 16
+            | static_cast<uint32_t>(static_cast<unsigned char>(text[pos + 1])) << 8
+            | static_cast<uint32_t>(static_cast<unsigned char>(text[pos + 2]));
+    }
+
+    //   
+    static std::vector<uint32_t> trigrams(std::string_view text) {
+        std::vector<uint32_t> result;
+        for (size_t i = 0; i + 3 <= text.size(); ++i) {
+            result.push_back(trigram(text, i));
+        }
+        std::sort(result.begin(), result.end());
+        result.erase(std::unique(result.begin(), result.end()), result.end());
+        return result;
+    }
+
+    void addPostings(std::string_view text, int id) {
+        for (uint32_t key : trigrams(text)) {
+            std::vector<int>& list = postings[key];
+            //      ID,     
+            list.insert(std::upper_bound(list.begin(), list.end(), id), id);
+        }
+    }
+
+    void removePostings(std::string_view text, int id) {
+        for (uint32_t key : trigrams(text)) {
+            auto it = postings.find(key);
+            if (it == postings.end()) continue;
+            std::vector<int>& list = it->second;
+            auto pos = std::lower_bound(list.begin(), list.end(), id);
+            if (pos != list.end() && *pos == id) {
+                list.erase(pos);
+            }
+            if (list.empty()) {
+                postings.erase(it);
+            }
+        }
+    }
+
+    bool contains(int id, const std::string& pattern) const {
+        const T* item = repo->find(id);
+        return item && textOf(*item).find(pattern) != std::string_view::npos;
+    }
+
+public:
+    explicit TrigramIndex(Getter getter) : getter(getter) {}
+
+    void onAttach(const Repository<T>& source) override {
+        repo = &source;
+    }
+
+    void onStore(const T* previous, const T& item) override {
+        std::string_view text = textOf(item);
+        if (previous) {
+            std::string_view oldText = textOf(*previous);
+            if (oldText == text) {
+                return;
+            }
+            removePostings(oldText, item.getId());
+        }
+        addPostings(text, item.getId());
+    }
+
+    void onErase(const T& item) override {
+        removePostings(textOf(item), item.getId());
+    }
+
+    void onClear() override {
+        postings.clear();
+    }
+
+    std::string_view fieldName() const override {
+        return nameOfField(getter);
+    }
+
+    //      :  -  
+    size_t estimateMatches(const std::string& pattern) const override {
+        if (pattern.size() < 3) {
+            return repo->size();
+        }
+        size_t smallest = repo->size();
+        for (uint32_t key : trigrams(pattern)) {
+            auto it = postings.find(key);
+            if (it == postings.end()) {
+                return 0;
+            }
+            smallest = std::min(smallest, it->second.size());
+        }
+        return smallest;
+    }
+
+    std::vector<int> match(const std::string& pattern) const override {
+        std::vector<int> result;
+        if (pattern.size() < 3) {
+            //     :   
+            repo->forEach([&](const T& item) {
+                if (textOf(item).find(pattern) != std::string_view::npos) {
+                    result.push_back(item.getId());
+                }
+                });
+            std::sort(result.begin(), result.end());
+            return result;
+        }
+
+        std::vector<const std::vector<int>*> lists;
+        for (uint32_t key : trigrams(pattern)) {
+            auto it = postings.find(key);
+            if (it == postings.end()) {
+                return result;
+            }
+            lists.push_back(&it->second);
+        }
+        std::sort(lists.begin(), lists.end(), [](const std::vector<int>* a, const std::vector<int>* b) {
+            return a->size() < b->size();
+            });
+
+        result = *lists.front();
+        for (size_t i = 1; i < lists.size() && !result.empty(); ++i) {
+            std::vector<int> next;
+            std::set_intersection(result.begin(), result.end(), lists[i]->begin(), lists[i]->end(), std::back_inserter(next));
+            result.swap(next);
+        }
+        //     ,    
+        result.erase(std::remove_if(result.begin(), result.end(), [this, &pattern](int id) {
+            return !contains(id, pattern);
+            }), result.end());
+        return result;
+    }
+};
+
+//  : makeTrigramIndex<Client>(&Client::getCompanyName)
+template<typename T, typename Getter>
+std::shared_ptr<TrigramIndex<T, Getter>> makeTrigramIndex(Getter getter) {
+    return std::make_shared<TrigramIndex<T, Getter>>(getter);
+}
+
+#endif // TRIGRAM_INDEX_H
\ No newline at end of file